@@ -0,0 +1,139 @@
+// 排程性能基准：在合成的运动会数据上比较贪心、局部搜索优化与完全搜索
+// 构建：cmake -S . -B build -DBUILD_BENCHMARKS=ON && cmake --build build --target schedule_bench
+// 用法：schedule_bench [时间上限毫秒，默认 2000]
+
+#include "SportsMeet.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+// 合成运动会的规模
+struct MeetSize {
+    const char* label;
+    int units;
+    int athletesPerUnit;
+    int eventsPerGender;
+    int eventsPerAthlete;
+    int days;
+};
+
+// 在执行期间丢弃 std::cout 的输出，析构时恢复
+class SilenceOutput {
+public:
+    SilenceOutput() : saved(std::cout.rdbuf(sink.rdbuf())) {}
+    ~SilenceOutput() { std::cout.rdbuf(saved); }
+private:
+    std::ostringstream sink;
+    std::streambuf* saved;
+};
+
+void buildMeet(SportsMeet& sm, const MeetSize& size, unsigned seed) {
+    SilenceOutput silence;
+    std::mt19937 rng(seed);
+    sm.setCompetitionDays(size.days);
+    sm.setMaxEventsPerAthlete(size.eventsPerAthlete);
+    const ScoringRule& rule = sm.getScoringRules()[0];
+
+    const Gender genders[] = {Gender::MALE, Gender::FEMALE};
+    for (Gender gender : genders) {
+        for (int e = 0; e < size.eventsPerGender; ++e) {
+            bool track = e % 2 == 0;
+            int duration = track ? 30 + 5 * (e % 4) : 60 + 5 * (e % 3);
+            sm.addEvent("项目" + std::to_string(e), gender, track, rule, duration);
+        }
+    }
+
+    std::uniform_int_distribution<int> pickEvent(0, size.eventsPerGender - 1);
+    for (int u = 0; u < size.units; ++u) {
+        std::string unitName = "单位" + std::to_string(u);
+        sm.addUnit(unitName);
+        for (int a = 0; a < size.athletesPerUnit; ++a) {
+            std::string id = "U" + std::to_string(u) + "A" + std::to_string(a);
+            Gender gender = genders[a % 2];
+            sm.addAthleteToUnit(unitName, id, "运动员" + id, gender);
+            for (int k = 0; k < size.eventsPerAthlete; ++k) {
+                sm.registerAthleteForEvent(id, "项目" + std::to_string(pickEvent(rng)), gender);
+            }
+        }
+    }
+}
+
+// 秩序册的全部场次（天, 开始时间, 场地, 项目, 组号），用于比较串行与并行生成的结果
+std::vector<std::tuple<int, int, std::string, const Event*, int>> scheduleFingerprint(const SportsMeet& sm) {
+    std::vector<std::tuple<int, int, std::string, const Event*, int>> sessions;
+    for (const auto& session : sm.schedule.getFullSchedule()) {
+        sessions.emplace_back(session.day, session.startTime, session.venue, session.event, session.heat);
+    }
+    return sessions;
+}
+
+template <typename Fn>
+double timeMillis(Fn&& fn) {
+    auto begin = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int limitMillis = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+    const int threads = 4; // 并行贪心的线程数
+
+    // 前三组天数充足；后四组天数偏紧，用于比较贪心失败、完全搜索找到方案、超时与证明无解的情形
+    const MeetSize sizes[] = {
+        {"小型", 4, 16, 6, 2, 2},
+        {"中型", 8, 40, 10, 2, 3},
+        {"大型", 16, 80, 16, 3, 4},
+        {"偏紧", 8, 40, 12, 3, 2},
+        {"较紧", 8, 40, 18, 3, 3},
+        {"困难", 8, 40, 14, 3, 2},
+        {"超载", 8, 40, 16, 3, 1},
+    };
+
+    std::cout << "规模\t场次数\t贪心(毫秒)\t贪心" << threads << "线程(毫秒)\t并行结果\t贪心已安排\t优化(毫秒)\t完全搜索(毫秒)\t结论\n";
+
+    for (const MeetSize& size : sizes) {
+        SportsMeet sm;
+        buildMeet(sm, size, 42);
+
+        std::size_t greedyPlaced = 0;
+        double greedyTime, parallelTime, optimizeTime, exactTime;
+        bool sameResult;
+        ExactScheduler::Outcome outcome;
+        {
+            SilenceOutput silence;
+            sm.setScheduleThreads(threads);
+            parallelTime = timeMillis([&] { sm.generateSchedule(); });
+            const auto parallelSchedule = scheduleFingerprint(sm);
+            sm.setScheduleThreads(1);
+            greedyTime = timeMillis([&] { sm.generateSchedule(); });
+            sameResult = scheduleFingerprint(sm) == parallelSchedule;
+            greedyPlaced = sm.schedule.getFullSchedule().size();
+            optimizeTime = timeMillis([&] { sm.optimizeSchedule(limitMillis / 4); });
+            exactTime = timeMillis([&] { outcome = sm.generateScheduleExact(limitMillis); });
+        }
+
+        // 分组进行的项目每组一个场次
+        std::size_t sessionCount = 0;
+        for (const auto& event : sm.getAllEvents()) {
+            if (!event->isCancelled && !event->registeredAthletes.empty()) {
+                sessionCount += std::max<std::size_t>(event->heats.size(), 1);
+            }
+        }
+        std::cout << size.label << "\t" << sessionCount << "\t" << greedyTime << "\t" << parallelTime << "\t"
+                  << (sameResult ? "一致" : "不一致") << "\t" << greedyPlaced
+                  << "\t" << optimizeTime << "\t" << exactTime << "\t"
+                  << (outcome == ExactScheduler::Outcome::Found ? "找到方案"
+                      : outcome == ExactScheduler::Outcome::Infeasible ? "无可行方案" : "超时") << "\n";
+    }
+    return 0;
+}
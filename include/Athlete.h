@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include "Gender.h"
+#include "Handle.h"
+#include "Result.h"
 
 // 前向声明以避免循环依赖
 class Event;
@@ -15,15 +17,18 @@ public:
     std::string id;         // 学号/ID
     Gender gender;          // 使用Gender枚举
     Unit* unit;             // 所属单位
-    std::vector<std::string> registeredEvents;
+    AthleteHandle handle = INVALID_HANDLE; // 运动员句柄
+    std::vector<EventHandle> registeredEvents;
+    std::vector<ResultRef> results; // 本人成绩的反向索引，按录入顺序
     int score = 0;
 
     Athlete(const std::string& name, const std::string& id, Gender gender, Unit* unit);
 
     bool canRegister(int maxEvents) const;
-    void registerForEvent(const std::string& eventName);
-    void unregisterFromEvent(const std::string& eventName);
-    bool isRegisteredFor(const std::string& eventName) const;
+    void registerForEvent(EventHandle event);
+    void unregisterFromEvent(EventHandle event);
+    bool isRegisteredFor(EventHandle event) const;
+    void removeResultRefs(EventHandle event);
 };
 
 #endif // ATHLETE_H 
\ No newline at end of file
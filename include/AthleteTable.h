@@ -0,0 +1,44 @@
+#ifndef ATHLETETABLE_H
+#define ATHLETETABLE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Gender.h"
+#include "Handle.h"
+
+/**
+ * @brief 列式（SoA）运动员表
+ * @details 以运动员句柄为行号，各字段分别存放在并行数组中。
+ *          Athlete 对象仍是实体本身，本表镜像其常用于扫描与汇总的字段，
+ *          由 SportsMeet 在每个修改点同步维护；按性别/单位筛选与得分汇总
+ *          只需顺序遍历一两列，无需逐个解引用运动员对象。
+ */
+class AthleteTable {
+public:
+    std::vector<std::string> ids;
+    std::vector<std::string> names;
+    std::vector<Gender> genders;
+    std::vector<std::uint32_t> unitIndices;   // 所属单位在单位列表中的下标
+    std::vector<int> scores;
+    std::vector<int> registrationCounts;      // 已报名项目数
+
+    // 追加一行，行号必须等于运动员句柄
+    void addRow(AthleteHandle handle, const std::string& id, const std::string& name,
+                Gender gender, std::uint32_t unitIndex, int score);
+    std::size_t size() const { return ids.size(); }
+    void clear();
+
+    // 筛选，返回按句柄升序的运动员句柄
+    std::vector<AthleteHandle> selectByUnit(std::uint32_t unitIndex) const;
+    // 性别符合项目要求且报名项目数未达上限的运动员
+    std::vector<AthleteHandle> selectEligible(Gender eventGender, int maxEvents) const;
+    // 一次遍历按单位归集，每个单位内为按句柄升序的运动员句柄
+    std::vector<std::vector<AthleteHandle>> bucketByUnit(std::size_t unitCount) const;
+
+    // 按单位汇总
+    std::vector<int> scoreTotalsByUnit(std::size_t unitCount) const;
+    std::vector<int> countByUnit(std::size_t unitCount) const;
+};
+
+#endif // ATHLETETABLE_H
@@ -5,8 +5,25 @@
 #include <vector>
 #include <map>
 #include "ScoringRule.h"
-#include "Result.h"
 #include "Gender.h"
+#include "Venue.h"
+
+// 备份文件头：魔数与格式版本
+// 版本 1 为早期无文件头的格式，成绩以 "项目名_组别" 为键单独存放在文件末尾
+// 版本 3 增加排程时间步长
+// 版本 4 增加场地列表与项目类别
+// 版本 5 增加项目的比赛轮次
+// 版本 6 增加报名成绩
+constexpr int BACKUP_MAGIC = 0x4D535353; // "SSSM"
+constexpr int BACKUP_VERSION = 6;
+
+// 用于序列化的成绩数据结构（运动员以学号表示）
+struct ResultData {
+    std::string athleteId;
+    double performance;
+    int rank = 0;
+    int points = 0;
+};
 
 // 用于序列化的运动员数据结构
 struct AthleteData {
@@ -24,6 +41,15 @@ struct UnitData {
     std::vector<AthleteData> athletes;
 };
 
+// 用于序列化的轮次数据结构（运动员以学号表示）
+struct RoundData {
+    std::string name;
+    int qualifiersPerHeat = 0;
+    int fastestLosers = 0;
+    std::vector<std::string> entrants;
+    std::vector<ResultData> results;
+};
+
 // 用于序列化的项目数据结构
 struct EventData {
     std::string name;
@@ -33,6 +59,18 @@ struct EventData {
     std::string scoringRuleName;
     std::vector<std::string> registeredAthletes;
     int durationMinutes;
+    std::vector<ResultData> results; // 版本 2 起成绩随项目保存
+    Discipline discipline = Discipline::TRACK; // 版本 4 起保存，之前的文件按名称推断
+    std::vector<RoundData> rounds; // 版本 5 起保存，之前的文件只进行一轮
+    int currentRound = 0;
+    std::vector<ResultData> entryMarks; // 版本 6 起保存的报名成绩
+};
+
+// 用于序列化的场地数据结构
+struct VenueData {
+    std::string name;
+    unsigned capabilities = 0;
+    int lanes = 0;
 };
 
 // 用于序列化的总数据包
@@ -44,10 +82,12 @@ struct BackupData {
     int morningEndTime;
     int afternoonStartTime;
     int afternoonEndTime;
+    int scheduleTimeStep = 15; // 排程时间步长，版本 3 之前的文件使用默认值
+    std::vector<VenueData> allVenues; // 版本 4 之前的文件为空，保留当前场地设置
     std::vector<ScoringRule> allScoringRules;
     std::vector<UnitData> allUnits;
     std::vector<EventData> allEvents;
-    std::map<std::string, std::vector<Result>> allEventResults;
+    std::map<std::string, std::vector<ResultData>> legacyEventResults; // 仅用于读取版本 1 文件
 };
 
 #endif // BACKUPDATA_H 
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef CONFLICTGRAPH_H
+#define CONFLICTGRAPH_H
+
+#include <cstdint>
+#include <vector>
+#include "Handle.h"
+#include "Heat.h"
+
+class Event;
+
+/**
+ * @brief 场次冲突图
+ * @details 节点为待排的场次（整个项目或项目的一个分组），两个场次共享至少一名参赛者即连边，
+ *          表示不能同时进行。图由各场次的参赛者名单一次构建：按运动员归集其参加的场次，再两两连边。
+ *          着色结果中同色的场次互不冲突，团中的场次必须依次进行。
+ */
+class ConflictGraph {
+private:
+    std::vector<ScheduleUnit> nodes;
+    std::vector<std::vector<std::uint32_t>> adjacency; // 有序、无重复的邻接表
+    std::size_t edges = 0;
+
+public:
+    // 以给定场次为节点构建冲突图，节点编号即场次在列表中的下标
+    void build(const std::vector<ScheduleUnit>& units);
+
+    std::size_t nodeCount() const { return nodes.size(); }
+    std::size_t edgeCount() const { return edges; }
+    const ScheduleUnit& getUnit(std::uint32_t node) const { return nodes[node]; }
+    Event* getEvent(std::uint32_t node) const { return nodes[node].event; }
+    const std::vector<std::uint32_t>& neighbors(std::uint32_t node) const { return adjacency[node]; }
+
+    /**
+     * @brief DSATUR 着色
+     * @param colors 输出每个节点的颜色（从 0 开始）
+     * @param order 输出着色顺序，即从最受约束到最不受约束的场次顺序
+     * @return 使用的颜色数
+     */
+    int colorDsatur(std::vector<int>& colors, std::vector<std::uint32_t>& order) const;
+
+    // 贪心求一个极大团（从每个节点出发按度数扩展，取最大者），作为冲突下界
+    std::vector<std::uint32_t> greedyClique() const;
+
+    /**
+     * @brief 将颜色类分配到比赛日
+     * @details 按总时长从大到小，把每个颜色类放入当前负载最轻的一天，
+     *          同色场次互不冲突，因此同一天内只需错开场地。
+     * @return 每个节点的建议比赛日（从 1 开始）
+     */
+    std::vector<int> assignDays(const std::vector<int>& colors, int colorCount, int days) const;
+};
+
+#endif // CONFLICTGRAPH_H
@@ -5,22 +5,51 @@
 #include <vector>
 #include "ScoringRule.h"
 #include "Gender.h"
+#include "Handle.h"
+#include "Result.h"
+#include "Venue.h"
+#include "Heat.h"
+#include "Round.h"
 
 class Event {
 public:
     std::string name;
     Gender gender;  // 使用Gender枚举代替字符串
     bool isTimeBased; // true for track, false for field
-    std::vector<std::string> registeredAthletes;
+    Discipline discipline; // 竞赛类别，决定可用的场地
+    EventHandle handle = INVALID_HANDLE; // 项目句柄
+    std::vector<AthleteHandle> registeredAthletes;
+    std::vector<Result> entryMarks; // 报名时填报的成绩，第一轮分组时作为种子成绩
+    std::vector<Result> results; // 本项目的成绩记录，按录入顺序存放，计分后按名次排列
     bool isCancelled = false;
     ScoringRule scoringRule;
     int durationMinutes; // 添加表示持续时间的成员变量（分钟）
+    std::vector<Heat> heats; // 当前轮次的分组结果，为空表示整轮作为一个场次进行
+    std::vector<Round> rounds; // 多轮进行时的各轮设置，为空表示只进行一轮
+    int currentRound = 0;      // 正在进行的轮次下标
 
     Event(const std::string& name, Gender gender, bool isTimeBased, const ScoringRule& rule, int durationMinutes);
+    Event(const std::string& name, Gender gender, bool isTimeBased, Discipline discipline, const ScoringRule& rule, int durationMinutes);
 
-    void addAthlete(const std::string& athleteId);
-    void removeAthlete(const std::string& athleteId);
+    void addAthlete(AthleteHandle athlete);
+    void removeAthlete(AthleteHandle athlete);
     bool allowsGender(Gender athleteGender) const; // 检查项目是否允许特定性别参赛
+    // 设置运动员的报名成绩，不大于 0 表示没有报名成绩
+    void setEntryMark(AthleteHandle athlete, double performance);
+    // 运动员的报名成绩，没有时为 0
+    double entryMark(AthleteHandle athlete) const;
+
+    // 当前轮次是否为决赛（只进行一轮的项目总是决赛）
+    bool inFinalRound() const;
+    // 当前轮次的参赛者：第一轮为报名名单
+    const std::vector<AthleteHandle>& roundEntrants() const;
+    // 当前轮次的成绩：决赛为项目成绩
+    std::vector<Result>& roundResults();
+    const std::vector<Result>& roundResults() const;
+    // 轮次名称，只进行一轮的项目为空
+    std::string roundName(int round) const;
+    // 成绩 a 是否优于 b（计时项目越小越好，计分项目越大越好）
+    bool better(double a, double b) const { return isTimeBased ? a < b : a > b; }
 };
 
 #endif // EVENT_H
\ No newline at end of file
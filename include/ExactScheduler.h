@@ -0,0 +1,61 @@
+#ifndef EXACTSCHEDULER_H
+#define EXACTSCHEDULER_H
+
+#include <chrono>
+#include <vector>
+#include "SchedulePlan.h"
+
+/**
+ * @brief 完全搜索排程：带约束传播与剪枝的回溯搜索，有时间上限
+ * @details 每层选择剩余可行安排最少的项目（最受约束优先），按天、场地、开始时间的顺序
+ *          尝试取值。放置后对所有未安排项目做前向检查，任一项目无处可放即回溯；
+ *          同时对每组可用场地比较只能使用这组场地的剩余项目总时长与剩余空闲时长，容量不足时剪枝。
+ *          各比赛日的时间窗口相同，只允许使用已用过的天或下一个新的一天，消除天之间的对称性；
+ *          可用项目完全相同的场地同理，尚未使用的这类场地只尝试第一个。
+ *          方案中有已结束轮次的固定场次或最早开始时间时，它们涉及的各天和场地不参与对称性消除。
+ *          开始时间只取按步长对齐的值，在时间上限内搜索结束即可给出结论：
+ *          找到方案，或证明在该步长的开始时间下不存在方案。
+ */
+class ExactScheduler {
+public:
+    enum class Outcome {
+        Found,      // 找到可行方案，已写入 plan
+        Infeasible, // 搜索完毕，证明按步长对齐的开始时间下不存在可行方案
+        Timeout     // 达到时间上限，结论未知
+    };
+
+    struct Stats {
+        Outcome outcome = Outcome::Timeout;
+        long nodes = 0; // 搜索树节点数
+        double elapsedMillis = 0;
+    };
+
+    explicit ExactScheduler(SchedulePlan& plan);
+
+    // 撤下全部项目后从头搜索
+    Stats solve(std::chrono::milliseconds timeLimit);
+
+private:
+    SchedulePlan& plan;
+    std::chrono::steady_clock::time_point deadline;
+    long nodes = 0;
+    bool timedOut = false;
+    std::vector<int> starts; // 复用的候选开始时间缓冲区
+    // 各项目可用场地的不同组合，以及可用场地全部落在该组合内的项目
+    std::vector<std::vector<VenueHandle>> venueGroups;
+    std::vector<std::vector<std::uint32_t>> groupMembers;
+    // 按场地句柄：可用项目集合相同的场地中句柄最小者；以及当前是否已有项目使用
+    std::vector<VenueHandle> venueClass;
+    std::vector<char> venueUsed;
+
+    bool search(std::size_t placedCount, int maxDayUsed);
+    void buildVenueGroups();
+    // 每组场地上，只能使用这组场地的剩余项目总时长不超过这组场地剩余的空闲时长
+    bool venueCapacityHolds() const;
+    // 场地尚未使用，且项目可用场地中有一个同类的未使用场地排在它前面，尝试它是多余的
+    bool venueRedundant(std::uint32_t node, VenueHandle venue) const;
+    // 项目在前 dayLimit 天内可行的安排数，values 非空时同时收集 (天, 场地, 开始时间)
+    std::size_t countValues(std::uint32_t node, int dayLimit, std::vector<std::pair<int, std::pair<VenueHandle, int>>>* values);
+};
+
+#endif // EXACTSCHEDULER_H
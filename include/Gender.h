@@ -10,6 +10,9 @@ enum class Gender {
     MIXED   // 混合
 };
 
+// 性别枚举的取值个数，用于按性别分槽的数组
+constexpr int GENDER_COUNT = 3;
+
 // 将Gender枚举转换为字符串
 inline std::string genderToString(Gender gender) {
     switch (gender) {
@@ -0,0 +1,49 @@
+#ifndef HANDLE_H
+#define HANDLE_H
+
+#include <cstdint>
+#include <vector>
+
+// 运动员与项目的稠密整数句柄，内部关系一律使用句柄，字符串只出现在接口与持久化边界
+using AthleteHandle = std::uint32_t;
+using EventHandle = std::uint32_t;
+using VenueHandle = std::uint32_t;
+
+constexpr std::uint32_t INVALID_HANDLE = 0xFFFFFFFFu;
+
+/**
+ * @brief 句柄表，为实体分配稳定的 32 位句柄
+ * @details 句柄即表中的下标，按分配顺序递增且不会复用；
+ *          实体删除后对应槽位置空，旧句柄解析结果为 nullptr。
+ */
+template <typename T>
+class HandleTable {
+private:
+    std::vector<T*> slots;
+
+public:
+    // 为实体分配新句柄
+    std::uint32_t add(T* entity) {
+        slots.push_back(entity);
+        return static_cast<std::uint32_t>(slots.size() - 1);
+    }
+
+    // 释放句柄，之后该句柄不再解析到任何实体
+    void release(std::uint32_t handle) {
+        if (handle < slots.size()) {
+            slots[handle] = nullptr;
+        }
+    }
+
+    // 解析句柄，无效或已释放的句柄返回 nullptr
+    T* get(std::uint32_t handle) const {
+        return handle < slots.size() ? slots[handle] : nullptr;
+    }
+
+    // 已分配的句柄数量（包括已释放的），可作为按句柄索引的数组大小
+    std::size_t size() const { return slots.size(); }
+
+    void clear() { slots.clear(); }
+};
+
+#endif // HANDLE_H
@@ -0,0 +1,27 @@
+#ifndef HEAT_H
+#define HEAT_H
+
+#include <vector>
+#include "Handle.h"
+
+class Event;
+
+// 计时项目的一个分组，一组即一次比赛
+struct Heat {
+    int number = 0;                      // 组号，从 1 开始
+    std::vector<AthleteHandle> entrants; // 本组参赛者，按道次从小到大
+    std::vector<int> lanes;              // 与 entrants 一一对应的道次
+    int durationMinutes = 0;             // 本组的时长
+};
+
+// 排程单元：项目当前轮次不分组时的整轮，或其中的一个分组，排程时各占一个场次
+struct ScheduleUnit {
+    Event* event = nullptr;
+    int heat = 0;                                         // 组号，0 表示不分组
+    const std::vector<AthleteHandle>* entrants = nullptr; // 本场次的参赛者
+    int durationMinutes = 0;
+    int round = 0;                                        // 轮次下标，只进行一轮的项目为 0
+    const std::vector<int>* lanes = nullptr;              // 与 entrants 对应的道次，不分道时为 nullptr
+};
+
+#endif // HEAT_H
@@ -0,0 +1,32 @@
+#ifndef HEATALLOCATOR_H
+#define HEATALLOCATOR_H
+
+#include <vector>
+#include "Heat.h"
+
+/**
+ * @brief 计时项目的分组与道次分配
+ * @details 报名人数超过跑道数时按跑道数分成人数相差不超过一人的若干组。
+ *          参赛者按种子成绩排序后以蛇形顺序（1..n, n..1, ...）分入各组，使各组实力均衡；
+ *          组内种子越靠前的选手越靠近中间道。没有种子成绩的选手排在最后，保持报名顺序。
+ *          项目时长视为全部比赛的总时长，按人数比例分给各组。
+ */
+class HeatAllocator {
+public:
+    static constexpr int MIN_HEAT_MINUTES = 5; // 每组的最短时长
+
+    /**
+     * @param entrants 参赛者，按报名顺序
+     * @param seeds 与 entrants 对应的种子成绩（用时，越小越好），没有成绩时为 0
+     * @param laneCount 跑道数
+     * @param totalMinutes 项目的总时长
+     * @return 分组结果；人数不超过跑道数时只有一组
+     */
+    static std::vector<Heat> allocate(const std::vector<AthleteHandle>& entrants, const std::vector<double>& seeds,
+                                      int laneCount, int totalMinutes);
+
+    // 道次的安排顺序：从中间道向两侧交替，例如 8 道为 4 5 3 6 2 7 1 8
+    static std::vector<int> laneOrder(int laneCount);
+};
+
+#endif // HEATALLOCATOR_H
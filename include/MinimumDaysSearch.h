@@ -0,0 +1,57 @@
+#ifndef MINIMUMDAYSSEARCH_H
+#define MINIMUMDAYSSEARCH_H
+
+#include <chrono>
+#include <vector>
+#include "SchedulePlan.h"
+#include "ExactScheduler.h"
+
+/**
+ * @brief 最少比赛天数搜索
+ * @details 先由三个互相独立的下界取最大值：每组可用场地的总分钟数、参赛场次最多的运动员
+ *          （其场次两两之间需要休息时间）以及冲突图中的团；有固定场次时还不能少于它们用到的最后一天。
+ *          再以贪心排程作为可行性探测，从下界开始倍增找到可行的上界，然后二分查找贪心能够安排的最少天数。
+ *          各次探测复用同一个方案的冲突图、场地分组和 DSATUR 安排顺序，只修改天数并清空安排。
+ *          贪心结果仍高于下界时，可在时间上限内用完全搜索继续尝试更少的天数。
+ */
+class MinimumDaysSearch {
+public:
+    struct Bounds {
+        int venueDays = 1;   // 场地总时长下界
+        int athleteDays = 1; // 最忙运动员下界
+        int cliqueDays = 1;  // 冲突团下界
+        int fixedDays = 1;   // 已结束轮次的场次和之后轮次的最早开始时间涉及的最后一天
+
+        int lower() const;
+    };
+
+    struct Stats {
+        Bounds bounds;
+        int days = -1;           // 找到的最少天数，-1 表示在上限天数内贪心也无法安排
+        int probes = 0;          // 贪心探测次数
+        bool provenOptimal = false; // 等于下界，或完全搜索证明少一天无解（仅对按步长对齐的开始时间成立）
+        double elapsedMillis = 0;
+    };
+
+    MinimumDaysSearch(SchedulePlan& plan, int restMinutes);
+
+    // d 天内能否依次安排 count 个相互冲突、总时长为 minutes 的场次所需的最少天数：
+    // 同一天的相邻场次间隔休息时间，但每个时间窗口之间的间隔可以抵消一次休息
+    static int chainDays(long minutes, long count, long dailyMinutes, long windowCount, long restMinutes);
+
+    Bounds lowerBounds() const;
+    // 用贪心在 days 天内安排全部场次，成功时方案保留该安排
+    bool probe(int days);
+    // 在 [下界, maxDays] 中搜索最少天数，结束时方案为找到的天数下的安排；exactLimit 为 0 时不做完全搜索
+    Stats run(int maxDays, std::chrono::milliseconds exactLimit);
+
+private:
+    SchedulePlan& plan;
+    int rest;
+    std::vector<std::uint32_t> order; // DSATUR 安排顺序，各次探测共用
+    std::vector<int> starts;          // 复用的候选开始时间缓冲区
+
+    long dailyMinutes() const;
+};
+
+#endif // MINIMUMDAYSSEARCH_H
@@ -0,0 +1,132 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include <cassert>
+
+template <typename T>
+class ObjectPool;
+
+/**
+ * @brief 对象池删除器
+ * @details 关联了对象池时将对象归还给池，否则退化为普通的 delete，
+ *          因此 PoolPtr 既可以指向池中对象，也可以指向普通堆对象。
+ */
+template <typename T>
+struct PoolDeleter {
+    ObjectPool<T>* pool = nullptr;
+
+    void operator()(T* object) const {
+        if (pool) {
+            pool->destroy(object);
+        } else {
+            delete object;
+        }
+    }
+};
+
+// 指向池中对象的独占指针，用法与 std::unique_ptr 相同
+template <typename T>
+using PoolPtr = std::unique_ptr<T, PoolDeleter<T>>;
+
+/**
+ * @brief 按块分配的对象池（arena）
+ * @details 对象在固定大小的块中连续构造，地址在对象存活期间保持不变；
+ *          释放的槽位进入空闲链表供后续复用。所有对象销毁后调用 reset()
+ *          可在 O(1) 时间内整体回收，已分配的块保留下来供下一轮使用。
+ */
+template <typename T>
+class ObjectPool {
+public:
+    static constexpr std::size_t BlockSize = 256; // 每个块容纳的对象数
+
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    static_assert(sizeof(T) >= sizeof(Slot*), "对象需能容纳空闲链表指针");
+
+    std::vector<std::unique_ptr<Slot[]>> blocks;
+    std::size_t usedBlocks = 0;  // 正在使用的块数（其余块为 reset 后保留的）
+    std::size_t nextInBlock = 0; // 当前块中下一个未使用的槽位
+    Slot* freeList = nullptr;    // 已释放槽位组成的链表
+    std::size_t liveCount = 0;   // 存活对象数
+
+    static Slot*& nextFree(Slot* slot) {
+        return *reinterpret_cast<Slot**>(slot->storage);
+    }
+
+    Slot* allocate() {
+        if (freeList) {
+            Slot* slot = freeList;
+            freeList = nextFree(slot);
+            return slot;
+        }
+        if (usedBlocks == 0 || nextInBlock == BlockSize) {
+            if (usedBlocks == blocks.size()) {
+                blocks.push_back(std::make_unique<Slot[]>(BlockSize));
+            }
+            ++usedBlocks;
+            nextInBlock = 0;
+        }
+        return &blocks[usedBlocks - 1][nextInBlock++];
+    }
+
+    void release(Slot* slot) {
+        nextFree(slot) = freeList;
+        freeList = slot;
+    }
+
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ~ObjectPool() {
+        // 所有对象应已通过 PoolPtr 归还
+        assert(liveCount == 0);
+    }
+
+    // 在池中构造对象，返回裸指针，需配对调用 destroy
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = allocate();
+        try {
+            T* object = new (slot->storage) T(std::forward<Args>(args)...);
+            ++liveCount;
+            return object;
+        } catch (...) {
+            release(slot);
+            throw;
+        }
+    }
+
+    // 在池中构造对象并交给 PoolPtr 管理
+    template <typename... Args>
+    PoolPtr<T> make(Args&&... args) {
+        return PoolPtr<T>(create(std::forward<Args>(args)...), PoolDeleter<T>{this});
+    }
+
+    // 析构对象并将槽位放回空闲链表
+    void destroy(T* object) {
+        object->~T();
+        release(reinterpret_cast<Slot*>(object));
+        --liveCount;
+    }
+
+    // 整体回收：所有对象销毁后将池恢复为空，保留已分配的块
+    void reset() {
+        assert(liveCount == 0);
+        usedBlocks = 0;
+        nextInBlock = 0;
+        freeList = nullptr;
+    }
+
+    std::size_t size() const { return liveCount; }
+};
+
+#endif // OBJECTPOOL_H
@@ -0,0 +1,30 @@
+#ifndef REGISTRATIONMATRIX_H
+#define REGISTRATIONMATRIX_H
+
+#include <cstdint>
+#include <vector>
+#include "Handle.h"
+
+/**
+ * @brief 运动员 × 项目的报名位矩阵
+ * @details 每个运动员一行，按项目句柄置位，每 64 个项目占一个字。
+ *          重复报名检查是一次位测试。行宽随项目句柄增长按需扩展。
+ */
+class RegistrationMatrix {
+private:
+    static constexpr std::uint32_t WordBits = 64;
+    std::vector<std::vector<std::uint64_t>> rows; // 按运动员句柄索引
+
+    std::vector<std::uint64_t>& row(AthleteHandle athlete);
+
+public:
+    void set(AthleteHandle athlete, EventHandle event);
+    void reset(AthleteHandle athlete, EventHandle event);
+    bool test(AthleteHandle athlete, EventHandle event) const;
+
+    // 清除某项目的整列，只访问给定的报名运动员
+    void clearEvent(EventHandle event, const std::vector<AthleteHandle>& entrants);
+    void clear() { rows.clear(); }
+};
+
+#endif // REGISTRATIONMATRIX_H
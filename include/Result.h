@@ -1,17 +1,23 @@
 #ifndef RESULT_H
 #define RESULT_H
 
-#include <string>
+#include "Handle.h"
 
 struct Result {
-    std::string athleteId;
+    AthleteHandle athlete = INVALID_HANDLE;
     double performance;
     int rank = 0;
     int points = 0;
 
     // Constructors
     Result() = default;
-    Result(std::string id, double perf) : athleteId(id), performance(perf) {}
+    Result(AthleteHandle a, double perf) : athlete(a), performance(perf) {}
+};
+
+// 运动员到成绩的反向引用：成绩位于 events[event]->results[index]
+struct ResultRef {
+    EventHandle event;
+    std::uint32_t index;
 };
 
 #endif // RESULT_H 
\ No newline at end of file
@@ -0,0 +1,26 @@
+#ifndef ROUND_H
+#define ROUND_H
+
+#include <string>
+#include <vector>
+#include "Handle.h"
+#include "Result.h"
+
+/**
+ * @brief 多轮进行的项目中的一轮（预赛、半决赛、决赛等）
+ * @details 第一轮的参赛者为报名名单；之后各轮的参赛者在上一轮成绩录入完整时按晋级规则产生。
+ *          决赛的成绩记入项目的 results 并参与计分，其余各轮的成绩只用于晋级。
+ */
+struct Round {
+    std::string name;              // 轮次名称
+    int qualifiersPerHeat = 0;     // 每组按名次直接晋级的人数（Q），决赛为 0
+    int fastestLosers = 0;         // 其余选手中按成绩择优晋级的人数（q），决赛为 0
+    std::vector<AthleteHandle> entrants; // 本轮参赛者，第一轮不使用（即报名名单）
+    std::vector<Result> results;   // 本轮成绩，决赛不使用（即项目成绩）
+
+    Round() = default;
+    Round(const std::string& name, int qualifiersPerHeat, int fastestLosers)
+        : name(name), qualifiersPerHeat(qualifiersPerHeat), fastestLosers(fastestLosers) {}
+};
+
+#endif // ROUND_H
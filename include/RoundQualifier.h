@@ -0,0 +1,38 @@
+#ifndef ROUNDQUALIFIER_H
+#define ROUNDQUALIFIER_H
+
+#include <vector>
+#include "Handle.h"
+#include "Heat.h"
+#include "Result.h"
+
+/**
+ * @brief 多轮项目的晋级计算
+ * @details 每组按成绩取前 perHeat 名直接晋级（Q），其余选手不分组按成绩择优取 fastestLosers 名（q）。
+ *          不分组的一轮视为只有一组；未被分入任何一组的参赛者（分组后才报名的）另作一组。
+ *          成绩相同时按参赛者在组内的顺序决定先后。
+ */
+class RoundQualifier {
+public:
+    struct Qualifier {
+        AthleteHandle athlete = INVALID_HANDLE;
+        double performance = 0;
+        bool byPlace = false; // true 为按组内名次晋级（Q），false 为按成绩择优晋级（q）
+    };
+
+    // 每名参赛者都已有成绩
+    static bool complete(const std::vector<AthleteHandle>& entrants, const std::vector<Result>& results);
+
+    /**
+     * @param heats 本轮分组，为空表示不分组
+     * @param entrants 本轮参赛者
+     * @param results 本轮成绩，没有成绩的参赛者不晋级
+     * @param lowerIsBetter 计时项目为 true
+     * @return 晋级名单：先是按名次晋级者，再是择优晋级者，各自按成绩从好到差
+     */
+    static std::vector<Qualifier> qualify(const std::vector<Heat>& heats, const std::vector<AthleteHandle>& entrants,
+                                          const std::vector<Result>& results, bool lowerIsBetter,
+                                          int perHeat, int fastestLosers);
+};
+
+#endif // ROUNDQUALIFIER_H
@@ -3,17 +3,30 @@
 
 #include <string>
 #include <vector>
-#include <map>
-#include <utility> // for std::pair
+#include <unordered_map>
+#include "Handle.h"
+#include "Heat.h"
+#include "Timeline.h"
 
 // 前向声明，避免循环依赖
 class Event;
 class Athlete;
+class Unit;
 class SportsMeet;
 
+/**
+ * @brief 场次的一名参赛者：句柄及添加场次时预解析的运动员和单位，打印秩序册时无需再查找运动员
+ */
+struct SessionEntrant {
+    AthleteHandle handle;
+    const Athlete* athlete;
+    const Unit* unit;
+    int lane; // 道次，0 表示不分道
+};
+
 /**
  * @brief 代表一个具体的、已安排的比赛日程
- *  包含时间、地点和比赛项目
+ *  包含时间、地点和比赛项目；多轮进行的项目每轮单独安排，分组进行的每组一个场次
  */
 struct ScheduledSession {
     int day;                // 第几天
@@ -21,9 +34,25 @@ struct ScheduledSession {
     int endTime;            // 结束时间 (从午夜开始的分钟数)
     std::string venue;      // 场地名称 (例如, "主田径场", "跳远沙坑")
     Event* event;           // 在此场次进行的项目
+    int round;              // 轮次下标，只进行一轮的项目为 0
+    int heat;               // 组号，0 表示不分组
+    std::vector<SessionEntrant> roster;  // 本场次的参赛者及其道次，是参赛名单的唯一来源
+
+    ScheduledSession(int d, int start, int end, const std::string& v, Event* e, int r, int h)
+        : day(d), startTime(start), endTime(end), venue(v), event(e), round(r), heat(h) {}
 
-    ScheduledSession(int d, int start, int end, const std::string& v, Event* e)
-        : day(d), startTime(start), endTime(end), venue(v), event(e) {}
+    // 按名单顺序取出参赛者句柄和道次，供以句柄列表为参数的接口使用；不分道时道次为空
+    std::vector<AthleteHandle> entrantHandles() const;
+    std::vector<int> laneNumbers() const;
+};
+
+/**
+ * @brief 某一天的排程负载，随场次的添加增量维护
+ */
+struct DayLoad {
+    int morningSessions = 0;   // 上午开始的场次数
+    int afternoonSessions = 0; // 下午开始的场次数
+    int minutesUsed = 0;       // 所有场次的累计时长
 };
 
 /**
@@ -33,23 +62,91 @@ class Schedule {
 private:
     SportsMeet& sm;
     std::vector<ScheduledSession> scheduled_sessions;
-    // 使用 <day, vector<pair<start, end>>> 结构记录繁忙时段
-    std::map<std::string, std::map<int, std::vector<std::pair<int, int>>>> venue_busy_slots;
-    std::map<std::string, std::map<int, std::vector<std::pair<int, int>>>> athlete_busy_slots;
+    // 场地名称只在此处解析为句柄，繁忙时段按句柄存放
+    std::unordered_map<std::string, VenueHandle> venue_handles;
+    std::vector<std::string> venue_names; // 按场地句柄索引
+    // 每个资源按天记录的分钟位图，分别按场地句柄和运动员句柄索引；
+    // 运动员位图记录的是已向两侧扩展了休息时间的占用
+    std::vector<ResourceTimeline> venue_timelines;
+    std::vector<ResourceTimeline> athlete_timelines;
+    std::vector<DayLoad> day_loads; // day_loads[day - 1]
+    // day_sessions[day - 1]：当天场次在 scheduled_sessions 中的下标，随添加按开始时间有序插入
+    std::vector<std::vector<std::uint32_t>> day_sessions;
+    // 个人赛程索引，按运动员句柄索引：该运动员参加的场次下标，按天和开始时间排序
+    std::vector<std::vector<std::uint32_t>> athlete_sessions;
+
+    // 按剩余场次重建某场地 / 某运动员某一天的位图，只访问当天或该运动员的场次
+    void rebuildVenueDay(VenueHandle venue, int day);
+    void rebuildAthleteDay(AthleteHandle athlete, int day);
 
 public:
+    static constexpr int ATHLETE_REST_MINUTES = 30; // 运动员两场比赛之间的强制休息时间
+    static constexpr int AFTERNOON_START = 13 * 60;  // 上下午的分界时间
+
     explicit Schedule(SportsMeet& sportsMeet);
 
-    // 添加一个已安排的场次
+    // 添加一个已安排的场次，参赛者为项目的全部报名者
     void addSession(int day, int startTime, int endTime, const std::string& venue, Event* event);
+    // 添加某项目某一轮（或其中一个分组）的场次，lanes 与 entrants 一一对应，为 nullptr 表示不分道
+    void addSession(int day, int startTime, int endTime, const std::string& venue, Event* event,
+                    int round, int heat, const std::vector<AthleteHandle>& entrants, const std::vector<int>* lanes);
+    // 原样加入一个已有的场次（例如保留的已结束轮次），沿用其参赛名单和道次
+    void addSession(ScheduledSession session);
+
+    // 获取场地句柄，首次出现的场地会分配新句柄
+    VenueHandle getVenueHandle(const std::string& venue);
+    const std::string& getVenueName(VenueHandle venue) const { return venue_names[venue]; }
 
     // 检查约束
     bool isVenueAvailable(const std::string& venue, int day, int startTime, int endTime) const;
+    bool isVenueAvailable(VenueHandle venue, int day, int startTime, int endTime) const;
     bool isAthleteAvailable(const Athlete* athlete, int day, int startTime, int endTime) const;
 
-    // 获取完整秩序册
+    // 某场次某天的合并占用位图：场地占用与全部参赛者（含休息时间）占用的按位或
+    DayBitmap blockedMask(const std::vector<AthleteHandle>& entrants, VenueHandle venue, int day) const;
+
+    // 某项目的全部场次下标（升序），经由项目报名者的个人赛程索引查找，不扫描整个秩序册
+    std::vector<std::uint32_t> sessionsOf(const Event* event) const;
+    // 给定运动员参加的全部场次下标（升序），经由个人赛程索引查找
+    std::vector<std::uint32_t> sessionsOfAthletes(const std::vector<AthleteHandle>& athletes) const;
+    const ScheduledSession& getSession(std::uint32_t index) const { return scheduled_sessions[index]; }
+    // 场次是否与同场地或同一参赛者（含休息时间）的其他场次重叠，只访问当天和参赛者的场次
+    bool sessionConflicts(std::uint32_t index) const;
+    // 移除给定下标的场次，其余场次保持不变；代价与被移除场次的参赛人数及相关日期的场次数成正比。
+    // 末尾的场次会移入空出的下标，调用后之前取得的下标失效
+    void removeSessions(std::vector<std::uint32_t> indices);
+    // 移除某项目的所有场次（项目被删除时调用），其余场次保持不变
+    void removeEvent(const Event* event);
+
+    // 获取某天的负载，没有场次的日期返回全零
+    DayLoad getDayLoad(int day) const;
+
+    // 获取完整秩序册，不保证顺序（移除场次时末尾的场次会填补空位）
     const std::vector<ScheduledSession>& getFullSchedule() const;
 
+    // 按天和开始时间的顺序访问全部场次，开始时间相同的按添加顺序
+    template <typename Fn>
+    void forEachInOrder(Fn&& fn) const {
+        for (const auto& sessions : day_sessions) {
+            for (std::uint32_t index : sessions) {
+                fn(scheduled_sessions[index]);
+            }
+        }
+    }
+
+    // 按天和开始时间的顺序访问某运动员参加的场次
+    template <typename Fn>
+    void forEachSessionOf(AthleteHandle athlete, Fn&& fn) const {
+        if (athlete >= athlete_sessions.size()) {
+            return;
+        }
+        for (std::uint32_t index : athlete_sessions[athlete]) {
+            fn(scheduled_sessions[index]);
+        }
+    }
+    // 某运动员参加的场次数
+    std::size_t getSessionCount(AthleteHandle athlete) const;
+
     void clear();
 };
 
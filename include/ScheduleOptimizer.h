@@ -0,0 +1,41 @@
+#ifndef SCHEDULEOPTIMIZER_H
+#define SCHEDULEOPTIMIZER_H
+
+#include <chrono>
+#include <random>
+#include "SchedulePlan.h"
+
+/**
+ * @brief 基于模拟退火的排程局部搜索
+ * @details 在贪心结果的基础上反复尝试两类邻域移动：把一个项目移到随机一个可用场地
+ *          随机一天的某个可行时间，或交换两个项目的时间（双方场地互相适用时连同场地一起交换）。只生成可行方案，按目标值用
+ *          Metropolis 准则接受，温度随已用时间（或迭代次数）几何下降。
+ *          结束时恢复到搜索过程中的最好方案。随机数种子固定，未触及时间上限时结果可复现。
+ */
+class ScheduleOptimizer {
+public:
+    struct Stats {
+        long iterations = 0;  // 尝试的移动次数
+        long accepted = 0;    // 接受的移动次数
+        double elapsedMillis = 0;
+        SchedulePlan::Objective before;
+        SchedulePlan::Objective after;
+    };
+
+    explicit ScheduleOptimizer(SchedulePlan& plan, unsigned seed = 20240901u);
+
+    // 在时间上限与迭代上限内优化方案，plan 被就地修改为找到的最好方案
+    Stats run(std::chrono::milliseconds budget, long maxIterations = 200000);
+
+private:
+    SchedulePlan& plan;
+    std::mt19937 rng;
+    std::vector<int> starts; // 复用的候选开始时间缓冲区
+
+    // 移动一个项目，成功生成新方案时返回 true，并记录原安排以便撤销
+    bool relocate(std::uint32_t& node, SchedulePlan::Placement& old);
+    // 交换两个已安排项目的时间，并记录原安排以便撤销
+    bool swap(std::uint32_t& a, std::uint32_t& b, SchedulePlan::Placement& oldA, SchedulePlan::Placement& oldB);
+};
+
+#endif // SCHEDULEOPTIMIZER_H
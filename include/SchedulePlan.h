@@ -0,0 +1,124 @@
+#ifndef SCHEDULEPLAN_H
+#define SCHEDULEPLAN_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "ConflictGraph.h"
+#include "Handle.h"
+#include "Timeline.h"
+
+class Event;
+class Schedule;
+
+/**
+ * @brief 独立于 Schedule 的排程方案，供优化与搜索算法反复修改
+ * @details 每个场次（整个项目或项目的一个分组）一条安排记录（场地、天、开始时间），可以随时移动或撤销。
+ *          场次可以安排在任一适合其项目类别的场地上；某场次在某场地某天的可用时间
+ *          由冲突图中的相邻场次（加休息时间）和同场地场次即时合成，
+ *          因此撤销安排不需要维护额外的计数结构。确定后通过 commit 写回秩序册。
+ *          多轮项目已结束轮次的场次作为固定场次加入：占用场地和参赛者，但不参与搜索；
+ *          之后轮次的场次只能在上一轮结束并休息之后开始。
+ */
+class SchedulePlan {
+public:
+    struct Placement {
+        Event* event;
+        VenueHandle venue;
+        int day = -1;       // -1 表示尚未安排
+        int startTime = -1;
+        int duration = 0;
+        int heat = 0;       // 组号，0 表示不分组
+        const std::vector<AthleteHandle>* entrants = nullptr;
+        int round = 0;      // 轮次下标
+        const std::vector<int>* lanes = nullptr; // 与 entrants 对应的道次，不分道时为 nullptr
+
+        bool placed() const { return day != -1; }
+        int endTime() const { return startTime + duration; }
+    };
+
+    // 已结束轮次的场次，位置固定，commit 时原样写回
+    struct FixedSession {
+        Event* event;
+        VenueHandle venue;
+        int day;
+        int startTime;
+        int endTime;
+        int round;
+        int heat;
+        std::vector<AthleteHandle> entrants;
+        std::vector<int> lanes;
+    };
+
+    // 方案的目标值，各项越小越好
+    struct Objective {
+        int unscheduled = 0;      // 未安排的场次数
+        int daysUsed = 0;         // 用到的最后一天
+        int imbalance = 0;        // 各天上下午场次数之差的绝对值之和
+        int idleVenueMinutes = 0; // 各场地每天首末场次之间的空闲分钟数
+
+        // 加权总分：依次优先保证全部安排、减少天数、上下午均衡、压缩场地空闲
+        long total() const {
+            return unscheduled * 1000000L + daysUsed * 10000L + imbalance * 100L + idleVenueMinutes;
+        }
+    };
+
+    SchedulePlan(int days, std::vector<std::pair<int, int>> windows, int timeStep);
+
+    // 添加场次及其可用场地，day 为 -1 表示尚未安排；全部添加后调用 finalize
+    void addUnit(const ScheduleUnit& unit, std::vector<VenueHandle> allowed, VenueHandle venue, int day = -1, int startTime = -1);
+    // 添加已结束轮次的场次，须在 finalize 之前调用
+    void addFixed(FixedSession session);
+    // 场次不能早于 day 天 minute 分开始（上一轮结束并休息之后）
+    void setEarliestStart(std::uint32_t node, int day, int minute);
+    // 构建冲突图和场地分组
+    void finalize();
+
+    std::size_t size() const { return placements.size(); }
+    int getDays() const { return days; }
+    // 修改比赛天数，已有安排保持不变（超出天数的安排不再有效）
+    void setDays(int newDays) { days = newDays; }
+    Placement& at(std::uint32_t node) { return placements[node]; }
+    const Placement& at(std::uint32_t node) const { return placements[node]; }
+    const std::vector<Placement>& getPlacements() const { return placements; }
+    const std::vector<FixedSession>& getFixed() const { return fixedSessions; }
+    // 固定场次和最早开始时间涉及的最后一天，没有时为 0；此后的各天彼此等价
+    int lastConstrainedDay() const;
+    const ConflictGraph& getConflicts() const { return conflicts; }
+    const std::vector<std::pair<int, int>>& getWindows() const { return windows; }
+    // 场次可以使用的场地
+    const std::vector<VenueHandle>& allowedVenues(std::uint32_t node) const { return venueOptions[node]; }
+    bool venueAllowed(std::uint32_t node, VenueHandle venue) const;
+
+    // 除该场次自身以外，当天占用指定场地或与其参赛者冲突（含休息时间）的分钟，以及最早开始时间之前的分钟
+    DayBitmap blockedMask(std::uint32_t node, VenueHandle venue, int day) const;
+    // 该场次在指定场地当天所有可行的开始时间
+    void feasibleStarts(std::uint32_t node, VenueHandle venue, int day, std::vector<int>& starts) const;
+    // 开始时间是否对齐步长并完整落在某个时间窗口内
+    bool fitsWindow(int startTime, int duration) const;
+    // 开始时间所在的时间窗口下标，不在任何窗口内时返回 -1
+    int windowIndex(int startTime) const;
+    bool canPlace(std::uint32_t node, VenueHandle venue, int day, int startTime) const;
+    // 已有安排是否仍然满足约束：场地适合该项目，在比赛天数和某个时间窗口内，且与其他场次无冲突（不要求对齐步长）
+    bool placementValid(std::uint32_t node) const;
+
+    Objective evaluate() const;
+
+    // 清空秩序册并按方案重新写入固定场次和全部已安排的场次
+    void commit(Schedule& schedule) const;
+
+private:
+    int days;
+    std::vector<std::pair<int, int>> windows;
+    int timeStep;
+    std::vector<Placement> placements;
+    ConflictGraph conflicts;
+    std::vector<std::vector<VenueHandle>> venueOptions;   // 每个场次可用的场地
+    std::vector<std::vector<std::uint32_t>> venueMembers; // 按场地句柄分组的可能使用该场地的场次
+    std::vector<std::pair<int, int>> earliest;            // 每个场次最早可以开始的 (天, 分钟)
+    std::vector<FixedSession> fixedSessions;
+    std::vector<std::vector<std::uint32_t>> fixedNeighbors; // 每个场次：与之共享参赛者的固定场次
+    std::vector<std::vector<std::uint32_t>> fixedByVenue;   // 按场地句柄分组的固定场次
+};
+
+#endif // SCHEDULEPLAN_H
@@ -7,41 +7,148 @@
 #include "ScoringRule.h"
 #include "Schedule.h" // 包含 Schedule 头文件
 #include "Gender.h"
+#include "Venue.h"
+#include "Handle.h"
+#include "ObjectPool.h"
+#include "AthleteTable.h"
+#include "RegistrationMatrix.h"
+#include "SchedulePlan.h"
+#include "ExactScheduler.h"
 #include <vector>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <array>
 #include <algorithm>
 #include <chrono>
 
 #include <map>
 #include "Result.h"
 
+class ThreadPool;
+
 class SportsMeet {
 private:
-    std::vector<std::unique_ptr<Unit>> units;
-    std::vector<std::unique_ptr<Event>> events; // 统一的事件列表
-    std::map<std::string, std::vector<Result>> eventResults;
+    // 实体对象池：必须声明在 units/events 之前，保证析构时晚于其中的对象
+    ObjectPool<Athlete> athletePool;
+    ObjectPool<Unit> unitPool;
+    ObjectPool<Event> eventPool;
+
+    std::vector<PoolPtr<Unit>> units;
+    std::vector<PoolPtr<Event>> events; // 统一的事件列表，成绩由各项目自行保存
     
     // 排程参数
-    std::vector<std::string> venues; // 可用场地列表
+    std::vector<Venue> venues;       // 可用场地列表
     int competitionDays;             // 比赛总天数
     int morningStartTime;            // 上午比赛开始时间 (分钟)
     int morningEndTime;              // 上午比赛结束时间 (分钟)
     int afternoonStartTime;          // 下午比赛开始时间 (分钟)
     int afternoonEndTime;            // 下午比赛结束时间 (分钟)
+    int scheduleTimeStep;            // 排程开始时间的步长 (分钟)
+    int scheduleThreads;             // 排程候选评估的线程数，1 为串行（不保存到备份）
+    std::unique_ptr<ThreadPool> schedulePool; // 候选评估的线程池，只在设置线程数时重建，串行时为空
 
     // 系统设置
     int maxEventsPerAthlete;
     int minParticipantsForCancel;       // 项目取消的最低人数要求
     std::vector<ScoringRule> scoringRules; // 计分规则列表
     
-    // 用于运动员查找算法优化的内部数据结构
-    mutable std::unordered_map<std::string, Athlete*> athleteHashMap;
+    // 运动员学号索引：所有内部查找的唯一入口，随添加/恢复就地维护
+    std::unordered_map<std::string, Athlete*> athleteIndex;
+
+    // 项目复合键索引 (名称, 组别)：按名称哈希，每个名称下按组别分槽，查找无需拼接键
+    std::unordered_map<std::string, std::array<Event*, GENDER_COUNT>> eventIndex;
+
+    // 列式运动员表，按句柄镜像运动员的扫描常用字段
+    AthleteTable athleteTable;
+
+    // 报名位矩阵：重复报名检查
+    RegistrationMatrix registrations;
+
+    // 上次生成或修复秩序册之后报名、轮次或场地有变动的项目，作为增量修复的输入
+    std::vector<EventHandle> scheduleChanges;
+
+    // 句柄表：内部关系中的句柄到实体的 O(1) 解析
+    HandleTable<Athlete> athleteHandles;
+    HandleTable<Event> eventHandles;
+
+    // 仅用于查找算法性能比较演示的排序数组（按需构建）
     mutable std::vector<std::pair<std::string, Athlete*>> sortedAthletes;
-    mutable bool isHashMapInitialized = false;
     mutable bool isSortedVectorInitialized = false;
 
+    // 将运动员登记到学号索引、分配句柄并写入列式表，学号重复时返回 false
+    bool indexAthlete(Athlete* athlete, std::uint32_t unitIndex);
+    // 给运动员及其单位加分
+    void awardPoints(Athlete* athlete, int points);
+    // 建立报名关系（调用方已通过位矩阵确认尚未报名），同步双方列表与位矩阵
+    void linkRegistration(Athlete* athlete, Event* event);
+    // 将项目登记到复合键索引并分配句柄
+    void indexEvent(Event* event);
+    // 从复合键索引中移除项目并释放句柄
+    void unindexEvent(Event* event);
+    // 按项目当前的成绩顺序重建相关运动员的成绩反向索引
+    void indexEventResults(Event* event);
+    // 原始线性查找，仅保留用于性能比较
+    Athlete* findAthleteLinear(const std::string& athleteId) const;
+
+    // 排程候选时间，score 越小越好，day 为 -1 表示没有可行时间
+    struct SlotCandidate {
+        long score = -1;
+        int day = -1;
+        int startTime = -1;
+        VenueHandle venue = INVALID_HANDLE;
+    };
+    // 排程时间步长的取值范围与默认值
+    static constexpr int MIN_TIME_STEP = 1;
+    static constexpr int MAX_TIME_STEP = 60;
+    static constexpr int DEFAULT_TIME_STEP = 15;
+    // 候选评估的任务（天 × 场地 × 时间窗口）少于此数时串行执行，线程同步的开销会超过并行的收益
+    static constexpr std::size_t PARALLEL_MIN_TASKS = 16;
+    // 评估场次在某一天各候选场地上的所有可行开始时间并返回当天最优者；只读访问秩序册，可并行调用
+    SlotCandidate evaluateDay(const ScheduleUnit& unit, const std::vector<VenueHandle>& venues, int day, int hintDay) const;
+    // 评估场次在某天某场地某个时间窗口内的可行开始时间并返回最优者，blocked 为该场地当天的合并占用；可并行调用
+    SlotCandidate evaluateWindow(const ScheduleUnit& unit, VenueHandle venue, int day, const std::pair<int, int>& window,
+                                 int hintDay, const DayBitmap& blocked, const DayLoad& load) const;
+    // 适合项目类别的全部场地，按场地列表顺序
+    std::vector<VenueHandle> venuesFor(const Event* event);
+    // 报告各场地在全部比赛日中的使用率
+    void showVenueUtilization() const;
+    // 检查所有项目的报名人数，标记参赛人数不足的项目为已取消
+    void cancelUnderfilledEvents();
+    // 检查单个项目的报名人数，人数不足时标记为已取消并返回 true
+    bool cancelIfUnderfilled(Event* event);
+    // 记录项目有变动，等待增量修复
+    void noteScheduleChange(const Event* event);
+    // 已安排的场次是否仍然有效：比赛日、场地、时间窗口均合法且不与其他场次冲突
+    bool sessionValid(std::uint32_t index);
+    // 需要安排的项目：未取消且有人报名
+    std::vector<Event*> eventsToSchedule() const;
+    // 计时项目可用的跑道数：适合该项目的场地中最少的跑道数，不分组的项目为 0
+    int laneCountFor(const Event* event) const;
+    // 报名人数超过跑道数的计时项目按跑道数分组，其余项目清空分组
+    void allocateHeats();
+    // 按项目当前轮次的参赛者分组，返回是否分组
+    bool allocateHeats(Event* event);
+    // 项目当前轮次的场次：分组时每组一个场次，否则整轮一个场次
+    void appendRoundUnits(Event* event, std::vector<ScheduleUnit>& units) const;
+    // 待排的全部场次：各项目当前轮次的场次
+    std::vector<ScheduleUnit> scheduleUnits() const;
+    // 已结束轮次的场次：未取消的多轮项目中轮次早于当前轮次的场次
+    std::vector<ScheduledSession> completedRoundSessions() const;
+    // 项目当前轮次最早可以开始的 (天, 分钟)：之前各轮最后一个场次结束并休息之后
+    std::pair<int, int> roundReadyTime(const Event* event) const;
+    // 以当前秩序册为起点构建排程方案，未出现在秩序册中的场次记为未安排；
+    // 已结束轮次的场次作为固定场次，之后轮次的场次不早于上一轮结束并休息之后
+    SchedulePlan makeSchedulePlan();
+    // 记录多轮项目非决赛轮次的成绩，本轮成绩录入完整时自动晋级
+    void recordRoundResult(Event* event, Athlete* athlete, double performance);
+    // 按本轮晋级规则产生下一轮的参赛者（没有成绩的参赛者不晋级），分组并立即安排下一轮的场次
+    void advanceRound(Event* event);
+    // 场次在 fromDay 天 fromMinute 之后最早可行的开始时间，day 为 -1 表示没有可行时间
+    SlotCandidate earliestSlot(const ScheduleUnit& unit, const std::vector<VenueHandle>& venues, int fromDay, int fromMinute) const;
+    // 在上一轮全部场次结束并休息之后，依次把项目当前轮次的场次安排到最早的可行时间
+    void scheduleCurrentRound(Event* event);
+
 public:
     Schedule schedule; // 秩序册对象
 
@@ -53,6 +160,8 @@ public:
     void setCompetitionDays(int days);                     // 新增：设置比赛天数
     void setMorningTimeWindow(int startHour, int startMinute, int endHour, int endMinute);
     void setAfternoonTimeWindow(int startHour, int startMinute, int endHour, int endMinute);
+    void setScheduleTimeStep(int minutes);
+    void setScheduleThreads(int threads);
     int getMaxEventsPerAthlete() const { return maxEventsPerAthlete; }
     int getCompetitionDays() const { return competitionDays; }  // 新增：获取比赛天数
     int getMorningStartHour() const { return morningStartTime / 60; }
@@ -63,14 +172,27 @@ public:
     int getAfternoonStartMinute() const { return afternoonStartTime % 60; }
     int getAfternoonEndHour() const { return afternoonEndTime / 60; }
     int getAfternoonEndMinute() const { return afternoonEndTime % 60; }
+    int getScheduleTimeStep() const { return scheduleTimeStep; }
+    int getScheduleThreads() const { return scheduleThreads; }
+
+    // --- 场地管理 ---
+    const std::vector<Venue>& getVenues() const { return venues; }
+    void addVenue(const std::string& name, unsigned capabilities, int lanes);
+    void removeVenue(const std::string& name);
+    void showVenues() const;
     
     void addUnit(const std::string& unitName);
     void addAthleteToUnit(const std::string& unitName, const std::string& athleteId, const std::string& athleteName, Gender gender);
     
     // --- 赛事管理 ---
     void addEvent(const std::string& name, Gender gender, bool isTimeBased, const ScoringRule& rule, int durationMinutes);
+    void addEvent(const std::string& name, Gender gender, bool isTimeBased, Discipline discipline, const ScoringRule& rule, int durationMinutes);
     void deleteEvent(const std::string& eventName, Gender gender);
     void cancelEvent(const std::string& eventName);
+    // 设置项目的比赛轮次（最后一轮为决赛），只有一轮时恢复为直接决赛；已有成绩的项目不能修改
+    void setEventRounds(const std::string& eventName, Gender gender, const std::vector<Round>& rounds);
+    // 提前结束多轮项目的当前轮次：未录入成绩的参赛者记为弃权（DNS），其余按成绩晋级
+    void closeEventRound(const std::string& eventName, Gender gender);
     void manageScoringRules();
     const std::vector<ScoringRule>& getScoringRules() const;
     
@@ -80,8 +202,8 @@ public:
     void showAllUnits() const; // For debugging/UI
     void showAllEvents() const; // For debugging/UI
     void showAllAthletes() const; // 新增：显示所有运动员
-    const std::vector<std::unique_ptr<Event>>& getAllEvents() const;
-    const std::vector<std::unique_ptr<Unit>>& getAllUnits() const;
+    const std::vector<PoolPtr<Event>>& getAllEvents() const;
+    const std::vector<PoolPtr<Unit>>& getAllUnits() const;
     
     // --- 查询功能 ---
     Unit* findUnit(const std::string& unitName);
@@ -89,15 +211,20 @@ public:
     Event* findEvent(const std::string& eventName, Gender gender);
     const Event* findEvent(const std::string& eventName, Gender gender) const;
     void showUnitDetails(const std::string& unitName) const;
+    // 列出可以报名某项目的运动员：性别符合、报名项目数未达上限且尚未报名
+    void showEligibleAthletes(const std::string& eventName, Gender gender) const;
     void showEventDetails(const std::string& eventName, Gender gender) const;
     void showUnitResults(const std::string& unitName) const;
     void showAthleteResults(const std::string& athleteId) const;
     
-    // 运动员查找方法 - 原始线性查找
+    // 运动员查找方法 - 基于学号索引 O(1)
     Athlete* findAthlete(const std::string& athleteId) const;
+    // 句柄解析 - O(1)，无效或已删除的句柄返回 nullptr
+    Athlete* getAthlete(AthleteHandle handle) const;
+    Event* getEvent(EventHandle handle) const;
     
     // 运动员查找算法优化相关方法
-    // 初始化哈希表和排序向量
+    // 初始化排序向量（哈希索引始终保持最新）
     void initializeAthleteSearchStructures() const;
     // 哈希表查找 - O(1)
     Athlete* findAthleteByHash(const std::string& athleteId) const;
@@ -109,13 +236,28 @@ public:
     // --- 秩序册 ---
     void generateSchedule();
     void showSchedule() const;
+    // 显示运动员的个人赛程
+    void showAthleteSchedule(const std::string& athleteId) const;
+    // 将单位全部运动员的个人赛程导出为 CSV 文件，返回导出的场次数，失败时返回 -1
+    int exportUnitTimetable(const std::string& unitName, const std::string& filename) const;
+    // 在时间上限内用局部搜索改进当前秩序册，报告优化前后的目标值
+    void optimizeSchedule(int budgetMillis);
+    // 增量修复秩序册：以上次排程之后记录的变动项目为输入，只重新分组和安排这些项目，
+    // 并重新检查与它们共享运动员的场次，其余场次原样保留
+    void repairSchedule();
+    void repairSchedule(const std::vector<Event*>& changedEvents);
+    // 完全搜索生成秩序册：找到方案或证明不存在方案，未找到方案时保留原秩序册
+    ExactScheduler::Outcome generateScheduleExact(int timeLimitMillis);
+    // 搜索能够安排全部场次的最少比赛天数，找到时设置比赛天数并采用对应的秩序册；返回天数，-1 表示未找到
+    int findMinimumDays(int timeLimitMillis);
 
     // --- 数据持久化 ---
     void backupData(const std::string& filename) const;
     void restoreData(const std::string& filename);
     
     // --- 报名管理 ---
-    void registerAthleteForEvent(const std::string& athleteId, const std::string& eventName, Gender eventGender);
+    // entryMark 为报名成绩，计时项目第一轮分组时作为种子成绩，不大于 0 表示没有
+    void registerAthleteForEvent(const std::string& athleteId, const std::string& eventName, Gender eventGender, double entryMark = 0);
 
     // --- 成绩与排名 ---
     void recordResult(const std::string& eventName, Gender eventGender, const std::string& athleteId, double performance);
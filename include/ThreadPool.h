@@ -0,0 +1,49 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 固定大小的线程池，只提供阻塞式的 parallelFor
+ * @details 工作线程在构造时创建并一直复用，调用 parallelFor 的线程同样参与执行。
+ *          任务按下标动态领取，返回前保证所有任务完成且没有工作线程仍在访问本次任务。
+ */
+class ThreadPool {
+public:
+    // threadCount 为参与计算的线程总数（含调用线程），至少为 1
+    explicit ThreadPool(unsigned threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 并行执行 task(0) ... task(count - 1)，阻塞直到全部完成
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    unsigned threadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;     // 通知工作线程有新任务或需要退出
+    std::condition_variable finished; // 通知调用线程任务已全部完成
+
+    const std::function<void(std::size_t)>* job = nullptr;
+    std::size_t jobCount = 0;
+    std::atomic<std::size_t> nextIndex{0};
+    std::size_t pending = 0;     // 尚未完成的任务数
+    unsigned activeWorkers = 0;  // 正在执行本次任务的工作线程数
+    unsigned generation = 0;     // 每次 parallelFor 递增，用于唤醒判断
+    bool stopping = false;
+
+    void workerLoop();
+    void runTasks(const std::function<void(std::size_t)>& task, std::size_t count);
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,67 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+constexpr int MINUTES_PER_DAY = 24 * 60;
+
+/**
+ * @brief 一天的分钟位图，每一位代表一分钟是否被占用
+ * @details 1440 分钟占 23 个 64 位字，区间重叠检查只需对涉及的几个字做按位与。
+ *          区间均为左闭右开 [start, end)，超出当天范围的部分会被截断。
+ */
+class DayBitmap {
+public:
+    static constexpr int Words = (MINUTES_PER_DAY + 63) / 64;
+
+    bool isFree(int start, int end) const;
+    void occupy(int start, int end);
+    void clear() { bits.fill(0); }
+
+    // 按位或合并另一张位图，定长的逐字循环便于编译器向量化
+    DayBitmap& operator|=(const DayBitmap& other) {
+        for (int i = 0; i < Words; ++i) {
+            bits[i] |= other.bits[i];
+        }
+        return *this;
+    }
+
+    // [start, end) 内第一个被占用 / 空闲的分钟，不存在时返回 end，按字做位扫描
+    int findOccupied(int start, int end) const;
+    int findFree(int start, int end) const;
+
+    // 在 [windowStart, windowEnd) 内找出所有可容纳 duration 分钟、且与 windowStart
+    // 相差 step 整数倍的开始时间；按空闲段跳跃，不逐个试探被占用的位置
+    void collectFreeStarts(int windowStart, int windowEnd, int duration, int step,
+                           std::vector<int>& starts) const;
+
+    const std::array<std::uint64_t, Words>& words() const { return bits; }
+
+private:
+    std::array<std::uint64_t, Words> bits{};
+
+    // 区间 [start, end) 落在第 word 个字中的掩码
+    static std::uint64_t rangeMask(int word, int start, int end);
+};
+
+/**
+ * @brief 单个资源（场地或运动员）按天划分的时间线
+ * @details 天数从 1 开始，位图在首次占用时按需分配。
+ */
+class ResourceTimeline {
+public:
+    bool isFree(int day, int start, int end) const;
+    void occupy(int day, int start, int end);
+    // 清空某一天的占用，供按剩余占用重建当天位图
+    void clearDay(int day);
+    // 获取某天的位图，该天没有任何占用时返回 nullptr
+    const DayBitmap* getDay(int day) const;
+    void clear() { days.clear(); }
+
+private:
+    std::vector<DayBitmap> days; // days[day - 1]
+};
+
+#endif // TIMELINE_H
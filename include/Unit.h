@@ -4,21 +4,42 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <map>
+#include <array>
 #include "Gender.h"
+#include "Handle.h"
+#include "ObjectPool.h"
 
 // 前向声明以避免循环依赖
 class Athlete;
 
+// 单位在某个项目中取得的一个名次
+struct UnitPlacing {
+    EventHandle event;
+    AthleteHandle athlete;
+    int rank;
+    double performance;
+    int points;
+};
+
 class Unit {
 public:
     std::string name;
     int score = 0;
-    std::vector<std::unique_ptr<Athlete>> athletes;
+    std::vector<PoolPtr<Athlete>> athletes;
+    ObjectPool<Athlete>* athletePool; // 运动员对象池，为空时直接在堆上分配
+
+    // 成绩汇总，随项目计分增量维护
+    std::vector<UnitPlacing> placings;        // 按项目句柄、名次排列
+    std::map<EventHandle, int> pointsByEvent; // 各项目得分
+    std::array<int, 3> medalCounts{};         // 第一、二、三名的数量
 
-    Unit(const std::string& name);
+    Unit(const std::string& name, ObjectPool<Athlete>* athletePool = nullptr);
 
-    void addAthlete(const std::string& athleteId, const std::string& athleteName, Gender gender);
+    Athlete* addAthlete(const std::string& athleteId, const std::string& athleteName, Gender gender);
     void addScore(int points);
+    void addPlacing(const UnitPlacing& placing);
+    void removePlacings(EventHandle event);
     Athlete* findAthlete(const std::string& athleteId);
 };
 
@@ -0,0 +1,66 @@
+#ifndef VENUE_H
+#define VENUE_H
+
+#include <string>
+
+// 项目的竞赛类别，决定项目可以使用哪些场地
+enum class Discipline {
+    TRACK,  // 径赛
+    JUMPS,  // 跳跃类田赛
+    THROWS  // 投掷类田赛
+};
+
+inline std::string disciplineToString(Discipline discipline) {
+    switch (discipline) {
+        case Discipline::TRACK: return "径赛";
+        case Discipline::JUMPS: return "跳跃";
+        case Discipline::THROWS: return "投掷";
+        default: return "未知";
+    }
+}
+
+// 根据项目名称和是否计时推断类别，用于旧版本数据和未指定类别的项目
+inline Discipline inferDiscipline(const std::string& name, bool isTimeBased) {
+    if (isTimeBased) {
+        return Discipline::TRACK;
+    }
+    for (const char* keyword : {"球", "标枪", "铁饼", "投"}) {
+        if (name.find(keyword) != std::string::npos) {
+            return Discipline::THROWS;
+        }
+    }
+    return Discipline::JUMPS;
+}
+
+// 场地能力标志，可按位组合
+enum VenueCapability : unsigned {
+    VENUE_TRACK = 1u << 0,  // 跑道
+    VENUE_JUMPS = 1u << 1,  // 跳跃区（沙坑、跳高区等）
+    VENUE_THROWS = 1u << 2  // 投掷区（投掷圈、护笼等）
+};
+
+inline unsigned capabilityFor(Discipline discipline) {
+    switch (discipline) {
+        case Discipline::TRACK: return VENUE_TRACK;
+        case Discipline::JUMPS: return VENUE_JUMPS;
+        case Discipline::THROWS: return VENUE_THROWS;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief 比赛场地
+ * @details 一个场地同一时间只进行一个项目；需要同时进行多个同类项目时声明多个场地。
+ */
+struct Venue {
+    std::string name;
+    unsigned capabilities; // VenueCapability 的组合
+    int lanes;             // 跑道数，非跑道场地为 0
+
+    Venue(const std::string& name, unsigned capabilities, int lanes = 0)
+        : name(name), capabilities(capabilities), lanes(lanes) {}
+
+    bool supports(Discipline discipline) const { return (capabilities & capabilityFor(discipline)) != 0; }
+};
+
+#endif // VENUE_H
@@ -9,17 +9,24 @@ bool Athlete::canRegister(int maxEvents) const {
     return registeredEvents.size() < maxEvents;
 }
 
-void Athlete::registerForEvent(const std::string& eventName) {
-    if (!isRegisteredFor(eventName)) {
-        registeredEvents.push_back(eventName);
+void Athlete::registerForEvent(EventHandle event) {
+    if (!isRegisteredFor(event)) {
+        registeredEvents.push_back(event);
     }
 }
 
-void Athlete::unregisterFromEvent(const std::string& eventName) {
-    auto it = std::remove(registeredEvents.begin(), registeredEvents.end(), eventName);
+void Athlete::unregisterFromEvent(EventHandle event) {
+    auto it = std::remove(registeredEvents.begin(), registeredEvents.end(), event);
     registeredEvents.erase(it, registeredEvents.end());
 }
 
-bool Athlete::isRegisteredFor(const std::string& eventName) const {
-    return std::find(registeredEvents.begin(), registeredEvents.end(), eventName) != registeredEvents.end();
+void Athlete::removeResultRefs(EventHandle event) {
+    auto it = std::remove_if(results.begin(), results.end(), [event](const ResultRef& ref) {
+        return ref.event == event;
+    });
+    results.erase(it, results.end());
+}
+
+bool Athlete::isRegisteredFor(EventHandle event) const {
+    return std::find(registeredEvents.begin(), registeredEvents.end(), event) != registeredEvents.end();
 } 
\ No newline at end of file
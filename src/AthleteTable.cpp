@@ -0,0 +1,71 @@
+#include "AthleteTable.h"
+#include <cassert>
+
+void AthleteTable::addRow(AthleteHandle handle, const std::string& id, const std::string& name,
+                          Gender gender, std::uint32_t unitIndex, int score) {
+    assert(handle == ids.size());
+    (void)handle; // 只用于断言，Release 构建中未使用
+    ids.push_back(id);
+    names.push_back(name);
+    genders.push_back(gender);
+    unitIndices.push_back(unitIndex);
+    scores.push_back(score);
+    registrationCounts.push_back(0);
+}
+
+void AthleteTable::clear() {
+    ids.clear();
+    names.clear();
+    genders.clear();
+    unitIndices.clear();
+    scores.clear();
+    registrationCounts.clear();
+}
+
+std::vector<AthleteHandle> AthleteTable::selectByUnit(std::uint32_t unitIndex) const {
+    std::vector<AthleteHandle> selected;
+    const std::uint32_t* column = unitIndices.data();
+    for (std::size_t row = 0, n = unitIndices.size(); row < n; ++row) {
+        if (column[row] == unitIndex) {
+            selected.push_back(static_cast<AthleteHandle>(row));
+        }
+    }
+    return selected;
+}
+
+std::vector<AthleteHandle> AthleteTable::selectEligible(Gender eventGender, int maxEvents) const {
+    std::vector<AthleteHandle> selected;
+    const Gender* genderColumn = genders.data();
+    const int* countColumn = registrationCounts.data();
+    for (std::size_t row = 0, n = genders.size(); row < n; ++row) {
+        if (genderAllowed(genderColumn[row], eventGender) && countColumn[row] < maxEvents) {
+            selected.push_back(static_cast<AthleteHandle>(row));
+        }
+    }
+    return selected;
+}
+
+std::vector<std::vector<AthleteHandle>> AthleteTable::bucketByUnit(std::size_t unitCount) const {
+    std::vector<std::vector<AthleteHandle>> buckets(unitCount);
+    const std::uint32_t* column = unitIndices.data();
+    for (std::size_t row = 0, n = unitIndices.size(); row < n; ++row) {
+        buckets[column[row]].push_back(static_cast<AthleteHandle>(row));
+    }
+    return buckets;
+}
+
+std::vector<int> AthleteTable::scoreTotalsByUnit(std::size_t unitCount) const {
+    std::vector<int> totals(unitCount, 0);
+    for (std::size_t row = 0, n = scores.size(); row < n; ++row) {
+        totals[unitIndices[row]] += scores[row];
+    }
+    return totals;
+}
+
+std::vector<int> AthleteTable::countByUnit(std::size_t unitCount) const {
+    std::vector<int> counts(unitCount, 0);
+    for (std::size_t row = 0, n = unitIndices.size(); row < n; ++row) {
+        counts[unitIndices[row]]++;
+    }
+    return counts;
+}
@@ -0,0 +1,138 @@
+#include "ConflictGraph.h"
+#include "Event.h"
+#include <algorithm>
+#include <numeric>
+
+void ConflictGraph::build(const std::vector<ScheduleUnit>& units) {
+    nodes = units;
+    adjacency.assign(nodes.size(), {});
+    edges = 0;
+
+    // 按运动员句柄归集其参加的场次节点
+    std::vector<std::vector<std::uint32_t>> eventsByAthlete;
+    for (std::uint32_t node = 0; node < nodes.size(); ++node) {
+        for (AthleteHandle athlete : *nodes[node].entrants) {
+            if (athlete >= eventsByAthlete.size()) {
+                eventsByAthlete.resize(athlete + 1);
+            }
+            eventsByAthlete[athlete].push_back(node);
+        }
+    }
+
+    // 同一运动员的场次两两冲突
+    for (const auto& shared : eventsByAthlete) {
+        for (std::size_t i = 0; i < shared.size(); ++i) {
+            for (std::size_t j = i + 1; j < shared.size(); ++j) {
+                adjacency[shared[i]].push_back(shared[j]);
+                adjacency[shared[j]].push_back(shared[i]);
+            }
+        }
+    }
+    for (auto& list : adjacency) {
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        edges += list.size();
+    }
+    edges /= 2;
+}
+
+int ConflictGraph::colorDsatur(std::vector<int>& colors, std::vector<std::uint32_t>& order) const {
+    const std::size_t n = nodes.size();
+    colors.assign(n, -1);
+    order.clear();
+    order.reserve(n);
+
+    // neighborColors[v][c] 表示 v 的邻居中是否已有颜色 c，saturation 为其中不同颜色数
+    std::vector<std::vector<char>> neighborColors(n);
+    std::vector<int> saturation(n, 0);
+    int colorCount = 0;
+
+    for (std::size_t step = 0; step < n; ++step) {
+        // 选择饱和度最大的未着色节点，其次度数最大，再次下标最小
+        std::uint32_t pick = 0;
+        bool found = false;
+        for (std::uint32_t v = 0; v < n; ++v) {
+            if (colors[v] != -1) continue;
+            if (!found || saturation[v] > saturation[pick] ||
+                (saturation[v] == saturation[pick] && adjacency[v].size() > adjacency[pick].size())) {
+                pick = v;
+                found = true;
+            }
+        }
+
+        // 取邻居未使用的最小颜色
+        int color = 0;
+        while (color < static_cast<int>(neighborColors[pick].size()) && neighborColors[pick][color]) {
+            ++color;
+        }
+        colors[pick] = color;
+        colorCount = std::max(colorCount, color + 1);
+        order.push_back(pick);
+
+        for (std::uint32_t u : adjacency[pick]) {
+            if (colors[u] != -1) continue;
+            auto& used = neighborColors[u];
+            if (static_cast<int>(used.size()) <= color) {
+                used.resize(color + 1, 0);
+            }
+            if (!used[color]) {
+                used[color] = 1;
+                saturation[u]++;
+            }
+        }
+    }
+    return colorCount;
+}
+
+std::vector<std::uint32_t> ConflictGraph::greedyClique() const {
+    std::vector<std::uint32_t> best;
+    for (std::uint32_t seed = 0; seed < nodes.size(); ++seed) {
+        if (adjacency[seed].size() < best.size()) continue; // 不可能得到更大的团
+
+        // 候选为种子的邻居，按度数从大到小尝试加入
+        std::vector<std::uint32_t> candidates = adjacency[seed];
+        std::stable_sort(candidates.begin(), candidates.end(), [this](std::uint32_t a, std::uint32_t b) {
+            return adjacency[a].size() > adjacency[b].size();
+        });
+        std::vector<std::uint32_t> clique{seed};
+        for (std::uint32_t v : candidates) {
+            bool adjacentToAll = std::all_of(clique.begin(), clique.end(), [this, v](std::uint32_t member) {
+                return std::binary_search(adjacency[v].begin(), adjacency[v].end(), member);
+            });
+            if (adjacentToAll) {
+                clique.push_back(v);
+            }
+        }
+        if (clique.size() > best.size()) {
+            best = std::move(clique);
+        }
+    }
+    return best;
+}
+
+std::vector<int> ConflictGraph::assignDays(const std::vector<int>& colors, int colorCount, int days) const {
+    std::vector<int> classMinutes(colorCount, 0);
+    for (std::uint32_t node = 0; node < nodes.size(); ++node) {
+        classMinutes[colors[node]] += nodes[node].durationMinutes;
+    }
+
+    std::vector<int> classOrder(colorCount);
+    std::iota(classOrder.begin(), classOrder.end(), 0);
+    std::stable_sort(classOrder.begin(), classOrder.end(), [&classMinutes](int a, int b) {
+        return classMinutes[a] > classMinutes[b];
+    });
+
+    std::vector<long> dayMinutes(std::max(days, 1), 0);
+    std::vector<int> classDay(colorCount, 1);
+    for (int color : classOrder) {
+        auto lightest = std::min_element(dayMinutes.begin(), dayMinutes.end());
+        *lightest += classMinutes[color];
+        classDay[color] = static_cast<int>(lightest - dayMinutes.begin()) + 1;
+    }
+
+    std::vector<int> dayHints(nodes.size());
+    for (std::uint32_t node = 0; node < nodes.size(); ++node) {
+        dayHints[node] = classDay[colors[node]];
+    }
+    return dayHints;
+}
@@ -2,24 +2,72 @@
 #include <algorithm>
 
 Event::Event(const std::string& name, Gender gender, bool isTimeBased, const ScoringRule& rule, int durationMinutes)
-    : name(name), gender(gender), isTimeBased(isTimeBased), scoringRule(rule), isCancelled(false), durationMinutes(durationMinutes)
+    : Event(name, gender, isTimeBased, inferDiscipline(name, isTimeBased), rule, durationMinutes)
 {
 }
 
-void Event::addAthlete(const std::string& athleteId) {
-    if (std::find(registeredAthletes.begin(), registeredAthletes.end(), athleteId) == registeredAthletes.end()) {
-        registeredAthletes.push_back(athleteId);
+Event::Event(const std::string& name, Gender gender, bool isTimeBased, Discipline discipline, const ScoringRule& rule, int durationMinutes)
+    : name(name), gender(gender), isTimeBased(isTimeBased), discipline(discipline), scoringRule(rule), isCancelled(false), durationMinutes(durationMinutes)
+{
+}
+
+void Event::addAthlete(AthleteHandle athlete) {
+    if (std::find(registeredAthletes.begin(), registeredAthletes.end(), athlete) == registeredAthletes.end()) {
+        registeredAthletes.push_back(athlete);
     }
 }
 
-void Event::removeAthlete(const std::string& athleteId) {
-    auto it = std::find(registeredAthletes.begin(), registeredAthletes.end(), athleteId);
+void Event::removeAthlete(AthleteHandle athlete) {
+    auto it = std::find(registeredAthletes.begin(), registeredAthletes.end(), athlete);
     if (it != registeredAthletes.end()) {
         registeredAthletes.erase(it);
     }
+    setEntryMark(athlete, 0);
+}
+
+void Event::setEntryMark(AthleteHandle athlete, double performance) {
+    auto it = std::find_if(entryMarks.begin(), entryMarks.end(), [athlete](const Result& mark) {
+        return mark.athlete == athlete;
+    });
+    if (performance <= 0) {
+        if (it != entryMarks.end()) {
+            entryMarks.erase(it);
+        }
+    } else if (it != entryMarks.end()) {
+        it->performance = performance;
+    } else {
+        entryMarks.emplace_back(athlete, performance);
+    }
+}
+
+double Event::entryMark(AthleteHandle athlete) const {
+    auto it = std::find_if(entryMarks.begin(), entryMarks.end(), [athlete](const Result& mark) {
+        return mark.athlete == athlete;
+    });
+    return it != entryMarks.end() ? it->performance : 0;
 }
 
 bool Event::allowsGender(Gender athleteGender) const {
     // 使用Gender.h中定义的全局函数
     return genderAllowed(athleteGender, this->gender);
-}
\ No newline at end of file
+}
+
+bool Event::inFinalRound() const {
+    return rounds.empty() || currentRound + 1 >= static_cast<int>(rounds.size());
+}
+
+const std::vector<AthleteHandle>& Event::roundEntrants() const {
+    return currentRound == 0 ? registeredAthletes : rounds[currentRound].entrants;
+}
+
+std::vector<Result>& Event::roundResults() {
+    return inFinalRound() ? results : rounds[currentRound].results;
+}
+
+const std::vector<Result>& Event::roundResults() const {
+    return inFinalRound() ? results : rounds[currentRound].results;
+}
+
+std::string Event::roundName(int round) const {
+    return round >= 0 && static_cast<std::size_t>(round) < rounds.size() ? rounds[round].name : "";
+}
@@ -0,0 +1,210 @@
+#include "ExactScheduler.h"
+#include <algorithm>
+
+ExactScheduler::ExactScheduler(SchedulePlan& plan) : plan(plan) {}
+
+ExactScheduler::Stats ExactScheduler::solve(std::chrono::milliseconds timeLimit) {
+    const auto begin = std::chrono::steady_clock::now();
+    deadline = begin + timeLimit;
+    nodes = 0;
+    timedOut = false;
+    for (std::uint32_t node = 0; node < plan.size(); ++node) {
+        plan.at(node).day = -1;
+        plan.at(node).startTime = -1;
+    }
+    buildVenueGroups();
+
+    Stats stats;
+    // 固定场次和最早开始时间使前面若干天互不等价，只有此后的新的一天才可以互换
+    if (search(0, plan.lastConstrainedDay())) {
+        stats.outcome = Outcome::Found;
+    } else {
+        stats.outcome = timedOut ? Outcome::Timeout : Outcome::Infeasible;
+        for (std::uint32_t node = 0; node < plan.size(); ++node) {
+            plan.at(node).day = -1;
+        }
+    }
+    stats.nodes = nodes;
+    stats.elapsedMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    return stats;
+}
+
+void ExactScheduler::buildVenueGroups() {
+    venueGroups.clear();
+    groupMembers.clear();
+    std::vector<std::vector<VenueHandle>> sortedOptions;
+    for (std::uint32_t node = 0; node < plan.size(); ++node) {
+        std::vector<VenueHandle> venues = plan.allowedVenues(node);
+        std::sort(venues.begin(), venues.end());
+        if (std::find(venueGroups.begin(), venueGroups.end(), venues) == venueGroups.end()) {
+            venueGroups.push_back(venues);
+        }
+        sortedOptions.push_back(std::move(venues));
+    }
+    // 可用项目集合相同的场地可以整体互换
+    std::vector<std::vector<std::uint32_t>> users;
+    for (std::uint32_t node = 0; node < plan.size(); ++node) {
+        for (VenueHandle venue : sortedOptions[node]) {
+            if (venue >= users.size()) {
+                users.resize(venue + 1);
+            }
+            users[venue].push_back(node);
+        }
+    }
+    venueClass.assign(users.size(), 0);
+    for (VenueHandle venue = 0; venue < users.size(); ++venue) {
+        venueClass[venue] = venue;
+        for (VenueHandle earlier = 0; earlier < venue; ++earlier) {
+            if (!users[venue].empty() && users[earlier] == users[venue]) {
+                venueClass[venue] = earlier;
+                break;
+            }
+        }
+    }
+    venueUsed.assign(users.size(), 0);
+
+    groupMembers.resize(venueGroups.size());
+    for (std::size_t group = 0; group < venueGroups.size(); ++group) {
+        const std::vector<VenueHandle>& venues = venueGroups[group];
+        for (std::uint32_t node = 0; node < plan.size(); ++node) {
+            const std::vector<VenueHandle>& options = sortedOptions[node];
+            if (std::includes(venues.begin(), venues.end(), options.begin(), options.end())) {
+                groupMembers[group].push_back(node);
+            }
+        }
+    }
+}
+
+bool ExactScheduler::venueCapacityHolds() const {
+    int windowMinutes = 0;
+    for (const auto& window : plan.getWindows()) {
+        windowMinutes += window.second - window.first;
+    }
+
+    std::vector<long> used; // 按场地句柄累计已安排的时长
+    for (const auto& p : plan.getPlacements()) {
+        if (!p.placed()) continue;
+        if (p.venue >= used.size()) {
+            used.resize(p.venue + 1, 0);
+        }
+        used[p.venue] += p.duration;
+    }
+    const long capacity = static_cast<long>(windowMinutes) * plan.getDays();
+    for (std::size_t group = 0; group < venueGroups.size(); ++group) {
+        long remaining = 0;
+        for (std::uint32_t node : groupMembers[group]) {
+            const SchedulePlan::Placement& p = plan.at(node);
+            if (!p.placed()) {
+                remaining += p.duration;
+            }
+        }
+        long available = 0;
+        for (VenueHandle venue : venueGroups[group]) {
+            available += capacity - (venue < used.size() ? used[venue] : 0);
+        }
+        if (remaining > available) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ExactScheduler::venueRedundant(std::uint32_t node, VenueHandle venue) const {
+    if (venueUsed[venue]) {
+        return false;
+    }
+    for (VenueHandle other : plan.allowedVenues(node)) {
+        if (other == venue) {
+            return false;
+        }
+        if (!venueUsed[other] && venueClass[other] == venueClass[venue]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t ExactScheduler::countValues(std::uint32_t node, int dayLimit,
+                                        std::vector<std::pair<int, std::pair<VenueHandle, int>>>* values) {
+    std::size_t count = 0;
+    for (int day = 1; day <= dayLimit; ++day) {
+        for (VenueHandle venue : plan.allowedVenues(node)) {
+            if (venueRedundant(node, venue)) continue;
+            starts.clear();
+            plan.feasibleStarts(node, venue, day, starts);
+            count += starts.size();
+            if (values) {
+                for (int start : starts) {
+                    values->push_back({day, {venue, start}});
+                }
+            }
+        }
+    }
+    return count;
+}
+
+bool ExactScheduler::search(std::size_t placedCount, int maxDayUsed) {
+    if (placedCount == plan.size()) {
+        return true;
+    }
+    if ((++nodes & 255) == 0 && std::chrono::steady_clock::now() >= deadline) {
+        timedOut = true;
+    }
+    if (timedOut || !venueCapacityHolds()) {
+        return false;
+    }
+    std::fill(venueUsed.begin(), venueUsed.end(), 0);
+    for (const auto& p : plan.getPlacements()) {
+        if (p.placed()) {
+            venueUsed[p.venue] = 1;
+        }
+    }
+    // 有固定场次的场地与同类的空场地不再等价
+    for (const auto& fixed : plan.getFixed()) {
+        if (fixed.venue < venueUsed.size()) {
+            venueUsed[fixed.venue] = 1;
+        }
+    }
+
+    // 新的一天彼此等价，只需尝试第一个未使用的天
+    const int dayLimit = std::min(plan.getDays(), maxDayUsed + 1);
+
+    // 前向检查并选择可行取值最少的未安排项目
+    std::uint32_t chosen = 0;
+    std::size_t chosenSize = 0;
+    bool found = false;
+    for (std::uint32_t node = 0; node < plan.size(); ++node) {
+        if (plan.at(node).placed()) continue;
+        std::size_t size = countValues(node, dayLimit, nullptr);
+        if (size == 0) {
+            return false;
+        }
+        if (!found || size < chosenSize) {
+            chosen = node;
+            chosenSize = size;
+            found = true;
+        }
+    }
+
+    std::vector<std::pair<int, std::pair<VenueHandle, int>>> values;
+    values.reserve(chosenSize);
+    countValues(chosen, dayLimit, &values);
+
+    SchedulePlan::Placement& p = plan.at(chosen);
+    const VenueHandle originalVenue = p.venue;
+    for (const auto& value : values) {
+        p.venue = value.second.first;
+        p.day = value.first;
+        p.startTime = value.second.second;
+        if (search(placedCount + 1, std::max(maxDayUsed, value.first))) {
+            return true;
+        }
+        p.venue = originalVenue;
+        p.day = -1;
+        p.startTime = -1;
+        if (timedOut) {
+            return false;
+        }
+    }
+    return false;
+}
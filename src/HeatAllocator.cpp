@@ -0,0 +1,64 @@
+#include "HeatAllocator.h"
+#include <algorithm>
+#include <numeric>
+
+std::vector<int> HeatAllocator::laneOrder(int laneCount) {
+    std::vector<int> order;
+    order.reserve(std::max(laneCount, 0));
+    int left = (laneCount + 1) / 2;
+    int right = left + 1;
+    while (left >= 1 || right <= laneCount) {
+        if (left >= 1) order.push_back(left--);
+        if (right <= laneCount) order.push_back(right++);
+    }
+    return order;
+}
+
+std::vector<Heat> HeatAllocator::allocate(const std::vector<AthleteHandle>& entrants, const std::vector<double>& seeds,
+                                          int laneCount, int totalMinutes) {
+    std::vector<Heat> heats;
+    const int total = static_cast<int>(entrants.size());
+    if (total == 0 || laneCount <= 0) {
+        return heats;
+    }
+
+    // 有种子成绩的按成绩从好到差，其余保持报名顺序排在后面
+    std::vector<std::size_t> order(entrants.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&seeds](std::size_t a, std::size_t b) {
+        bool seededA = a < seeds.size() && seeds[a] > 0;
+        bool seededB = b < seeds.size() && seeds[b] > 0;
+        if (seededA != seededB) return seededA;
+        return seededA && seeds[a] < seeds[b];
+    });
+
+    // 蛇形分组：第偶数轮按组号正序，第奇数轮倒序
+    const int heatCount = (total + laneCount - 1) / laneCount;
+    std::vector<std::vector<AthleteHandle>> members(heatCount);
+    for (int i = 0; i < total; ++i) {
+        int round = i / heatCount;
+        int position = i % heatCount;
+        int heat = (round % 2 == 0) ? position : heatCount - 1 - position;
+        members[heat].push_back(entrants[order[i]]);
+    }
+
+    const std::vector<int> lanes = laneOrder(laneCount);
+    heats.resize(heatCount);
+    for (int h = 0; h < heatCount; ++h) {
+        Heat& heat = heats[h];
+        heat.number = h + 1;
+        // 组内成员已按种子顺序排列，依次占用从中间向外的道次，再按道次排序
+        std::vector<std::pair<int, AthleteHandle>> byLane;
+        for (std::size_t k = 0; k < members[h].size(); ++k) {
+            byLane.push_back({lanes[k], members[h][k]});
+        }
+        std::sort(byLane.begin(), byLane.end());
+        for (const auto& entry : byLane) {
+            heat.lanes.push_back(entry.first);
+            heat.entrants.push_back(entry.second);
+        }
+        int share = (totalMinutes * static_cast<int>(heat.entrants.size()) + total - 1) / total;
+        heat.durationMinutes = std::max(share, MIN_HEAT_MINUTES);
+    }
+    return heats;
+}
@@ -0,0 +1,184 @@
+#include "MinimumDaysSearch.h"
+#include <algorithm>
+
+int MinimumDaysSearch::Bounds::lower() const {
+    return std::max({venueDays, athleteDays, cliqueDays, fixedDays, 1});
+}
+
+MinimumDaysSearch::MinimumDaysSearch(SchedulePlan& plan, int restMinutes) : plan(plan), rest(restMinutes) {
+    std::vector<int> colors;
+    plan.getConflicts().colorDsatur(colors, order);
+}
+
+int MinimumDaysSearch::chainDays(long minutes, long count, long dailyMinutes, long windowCount, long restMinutes) {
+    if (count <= 0 || dailyMinutes <= 0) {
+        return 1;
+    }
+    // 一天内 k 个场次至少有 k - 窗口数 次休息落在时间窗口内：
+    // 总时长 + 休息 * (场次数 - 窗口数 * d) <= d * 每日可用时长
+    const long perDay = dailyMinutes + windowCount * restMinutes;
+    return static_cast<int>(std::max(1L, (minutes + restMinutes * count + perDay - 1) / perDay));
+}
+
+long MinimumDaysSearch::dailyMinutes() const {
+    long minutes = 0;
+    for (const auto& window : plan.getWindows()) {
+        minutes += window.second - window.first;
+    }
+    return minutes;
+}
+
+MinimumDaysSearch::Bounds MinimumDaysSearch::lowerBounds() const {
+    Bounds bounds;
+    bounds.fixedDays = std::max(plan.lastConstrainedDay(), 1);
+    const long daily = dailyMinutes();
+    const long windowCount = static_cast<long>(plan.getWindows().size());
+    if (daily <= 0) {
+        return bounds;
+    }
+
+    // 场地：可用场地全部落在某组场地内的场次，总时长不超过这组场地每天的总时长乘以天数
+    std::vector<std::vector<VenueHandle>> options;
+    for (std::uint32_t node = 0; node < plan.size(); ++node) {
+        std::vector<VenueHandle> venues = plan.allowedVenues(node);
+        std::sort(venues.begin(), venues.end());
+        options.push_back(std::move(venues));
+    }
+    std::vector<std::vector<VenueHandle>> groups = options;
+    std::sort(groups.begin(), groups.end());
+    groups.erase(std::unique(groups.begin(), groups.end()), groups.end());
+    for (const auto& group : groups) {
+        if (group.empty()) continue;
+        long minutes = 0;
+        for (std::uint32_t node = 0; node < plan.size(); ++node) {
+            if (!options[node].empty() && std::includes(group.begin(), group.end(), options[node].begin(), options[node].end())) {
+                minutes += plan.at(node).duration;
+            }
+        }
+        const long capacity = daily * static_cast<long>(group.size());
+        bounds.venueDays = std::max(bounds.venueDays, static_cast<int>((minutes + capacity - 1) / capacity));
+    }
+
+    // 运动员：同一运动员的场次两两冲突，按休息时间串行
+    std::vector<long> athleteMinutes;
+    std::vector<long> athleteSessions;
+    for (const auto& p : plan.getPlacements()) {
+        for (AthleteHandle athlete : *p.entrants) {
+            if (athlete >= athleteMinutes.size()) {
+                athleteMinutes.resize(athlete + 1, 0);
+                athleteSessions.resize(athlete + 1, 0);
+            }
+            athleteMinutes[athlete] += p.duration;
+            athleteSessions[athlete]++;
+        }
+    }
+    for (std::size_t athlete = 0; athlete < athleteMinutes.size(); ++athlete) {
+        bounds.athleteDays = std::max(bounds.athleteDays,
+            chainDays(athleteMinutes[athlete], athleteSessions[athlete], daily, windowCount, rest));
+    }
+
+    // 冲突团：团中场次两两冲突，同样只能串行
+    long cliqueMinutes = 0;
+    std::vector<std::uint32_t> clique = plan.getConflicts().greedyClique();
+    for (std::uint32_t node : clique) {
+        cliqueMinutes += plan.at(node).duration;
+    }
+    bounds.cliqueDays = chainDays(cliqueMinutes, static_cast<long>(clique.size()), daily, windowCount, rest);
+    return bounds;
+}
+
+bool MinimumDaysSearch::probe(int days) {
+    plan.setDays(days);
+    for (std::uint32_t node = 0; node < plan.size(); ++node) {
+        plan.at(node).day = -1;
+        plan.at(node).startTime = -1;
+    }
+    // 按 DSATUR 顺序逐个放到最早的一天最早的时间，同一时间取列表中靠前的场地
+    for (std::uint32_t node : order) {
+        SchedulePlan::Placement& p = plan.at(node);
+        for (int day = 1; day <= days && !p.placed(); ++day) {
+            for (VenueHandle venue : plan.allowedVenues(node)) {
+                starts.clear();
+                plan.feasibleStarts(node, venue, day, starts);
+                if (starts.empty()) continue;
+                const int start = *std::min_element(starts.begin(), starts.end());
+                if (!p.placed() || start < p.startTime) {
+                    p.venue = venue;
+                    p.day = day;
+                    p.startTime = start;
+                }
+            }
+        }
+        if (!p.placed()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+MinimumDaysSearch::Stats MinimumDaysSearch::run(int maxDays, std::chrono::milliseconds exactLimit) {
+    const auto begin = std::chrono::steady_clock::now();
+    Stats stats;
+    stats.bounds = lowerBounds();
+    const int lower = stats.bounds.lower();
+    maxDays = std::max(maxDays, lower);
+
+    std::vector<SchedulePlan::Placement> best;
+    auto tryDays = [&](int days) {
+        stats.probes++;
+        if (probe(days)) {
+            stats.days = days;
+            best = plan.getPlacements();
+            return true;
+        }
+        return false;
+    };
+
+    // 从下界开始倍增，直到贪心能够安排
+    int failed = lower - 1; // 已知贪心无法安排的最大天数
+    for (int days = lower; ; days = std::min(days * 2, maxDays)) {
+        if (tryDays(days)) break;
+        failed = days;
+        if (days >= maxDays) break;
+    }
+
+    if (stats.days != -1) {
+        // 在 (failed, 已找到的天数) 之间二分
+        int low = failed + 1;
+        int high = stats.days;
+        while (low < high) {
+            const int mid = low + (high - low) / 2;
+            if (tryDays(mid)) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+        stats.provenOptimal = stats.days == lower;
+
+        // 完全搜索逐天尝试更少的天数，直到无解、超时或到达下界
+        const auto deadline = begin + exactLimit;
+        while (!stats.provenOptimal && exactLimit.count() > 0) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) break;
+            plan.setDays(stats.days - 1);
+            ExactScheduler solver(plan);
+            ExactScheduler::Outcome outcome = solver.solve(remaining).outcome;
+            if (outcome == ExactScheduler::Outcome::Found) {
+                stats.days--;
+                best = plan.getPlacements();
+                stats.provenOptimal = stats.days == lower;
+            } else {
+                stats.provenOptimal = outcome == ExactScheduler::Outcome::Infeasible;
+                break;
+            }
+        }
+
+        plan.setDays(stats.days);
+        for (std::uint32_t node = 0; node < plan.size(); ++node) {
+            plan.at(node) = best[node];
+        }
+    }
+    stats.elapsedMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    return stats;
+}
@@ -0,0 +1,39 @@
+#include "RegistrationMatrix.h"
+
+std::vector<std::uint64_t>& RegistrationMatrix::row(AthleteHandle athlete) {
+    if (athlete >= rows.size()) {
+        rows.resize(athlete + 1);
+    }
+    return rows[athlete];
+}
+
+void RegistrationMatrix::set(AthleteHandle athlete, EventHandle event) {
+    auto& words = row(athlete);
+    std::size_t word = event / WordBits;
+    if (word >= words.size()) {
+        words.resize(word + 1, 0);
+    }
+    words[word] |= std::uint64_t(1) << (event % WordBits);
+}
+
+void RegistrationMatrix::reset(AthleteHandle athlete, EventHandle event) {
+    if (athlete >= rows.size()) return;
+    auto& words = rows[athlete];
+    std::size_t word = event / WordBits;
+    if (word < words.size()) {
+        words[word] &= ~(std::uint64_t(1) << (event % WordBits));
+    }
+}
+
+bool RegistrationMatrix::test(AthleteHandle athlete, EventHandle event) const {
+    if (athlete >= rows.size()) return false;
+    const auto& words = rows[athlete];
+    std::size_t word = event / WordBits;
+    return word < words.size() && (words[word] >> (event % WordBits)) & 1;
+}
+
+void RegistrationMatrix::clearEvent(EventHandle event, const std::vector<AthleteHandle>& entrants) {
+    for (AthleteHandle athlete : entrants) {
+        reset(athlete, event);
+    }
+}
@@ -0,0 +1,74 @@
+#include "RoundQualifier.h"
+#include <algorithm>
+#include <unordered_map>
+
+bool RoundQualifier::complete(const std::vector<AthleteHandle>& entrants, const std::vector<Result>& results) {
+    if (entrants.empty()) {
+        return false;
+    }
+    return std::all_of(entrants.begin(), entrants.end(), [&results](AthleteHandle athlete) {
+        return std::any_of(results.begin(), results.end(), [athlete](const Result& result) {
+            return result.athlete == athlete;
+        });
+    });
+}
+
+std::vector<RoundQualifier::Qualifier> RoundQualifier::qualify(const std::vector<Heat>& heats,
+                                                               const std::vector<AthleteHandle>& entrants,
+                                                               const std::vector<Result>& results, bool lowerIsBetter,
+                                                               int perHeat, int fastestLosers) {
+    // 同一运动员有多条成绩时以最后录入的为准
+    std::unordered_map<AthleteHandle, double> performance;
+    for (const Result& result : results) {
+        performance[result.athlete] = result.performance;
+    }
+    auto better = [lowerIsBetter](const Qualifier& a, const Qualifier& b) {
+        return lowerIsBetter ? a.performance < b.performance : a.performance > b.performance;
+    };
+
+    // 按组收集有成绩的参赛者
+    std::vector<std::vector<Qualifier>> groups;
+    std::vector<AthleteHandle> grouped;
+    for (const Heat& heat : heats) {
+        groups.emplace_back();
+        for (AthleteHandle athlete : heat.entrants) {
+            grouped.push_back(athlete);
+            auto it = performance.find(athlete);
+            if (it != performance.end()) {
+                groups.back().push_back({athlete, it->second, false});
+            }
+        }
+    }
+    std::vector<Qualifier> ungrouped;
+    for (AthleteHandle athlete : entrants) {
+        if (std::find(grouped.begin(), grouped.end(), athlete) != grouped.end()) continue;
+        auto it = performance.find(athlete);
+        if (it != performance.end()) {
+            ungrouped.push_back({athlete, it->second, false});
+        }
+    }
+    if (!ungrouped.empty()) {
+        groups.push_back(std::move(ungrouped));
+    }
+
+    std::vector<Qualifier> byPlace;
+    std::vector<Qualifier> rest;
+    for (auto& group : groups) {
+        std::stable_sort(group.begin(), group.end(), better);
+        for (std::size_t i = 0; i < group.size(); ++i) {
+            if (i < static_cast<std::size_t>(std::max(perHeat, 0))) {
+                group[i].byPlace = true;
+                byPlace.push_back(group[i]);
+            } else {
+                rest.push_back(group[i]);
+            }
+        }
+    }
+    std::stable_sort(byPlace.begin(), byPlace.end(), better);
+    std::stable_sort(rest.begin(), rest.end(), better);
+    rest.resize(std::min(rest.size(), static_cast<std::size_t>(std::max(fastestLosers, 0))));
+
+    std::vector<Qualifier> qualifiers = std::move(byPlace);
+    qualifiers.insert(qualifiers.end(), rest.begin(), rest.end());
+    return qualifiers;
+}
@@ -4,56 +4,291 @@
 #include "SportsMeet.h"
 #include <algorithm>
 
-// 检查两个时间段 [start1, end1) 和 [start2, end2) 是否重叠
-bool timeRangesOverlap(int start1, int end1, int start2, int end2) {
-    return start1 < end2 && start2 < end1;
-}
-
 // 修改构造函数，接收 SportsMeet 引用
 Schedule::Schedule(SportsMeet& sportsMeet) : sm(sportsMeet) {}
 
 void Schedule::addSession(int day, int startTime, int endTime, const std::string& venue, Event* event) {
-    scheduled_sessions.emplace_back(day, startTime, endTime, venue, event);
+    addSession(day, startTime, endTime, venue, event, 0, 0, event->registeredAthletes, nullptr);
+}
+
+std::vector<AthleteHandle> ScheduledSession::entrantHandles() const {
+    std::vector<AthleteHandle> handles;
+    handles.reserve(roster.size());
+    for (const SessionEntrant& entrant : roster) {
+        handles.push_back(entrant.handle);
+    }
+    return handles;
+}
+
+std::vector<int> ScheduledSession::laneNumbers() const {
+    std::vector<int> lanes;
+    if (!roster.empty() && roster.front().lane > 0) {
+        lanes.reserve(roster.size());
+        for (const SessionEntrant& entrant : roster) {
+            lanes.push_back(entrant.lane);
+        }
+    }
+    return lanes;
+}
+
+void Schedule::addSession(int day, int startTime, int endTime, const std::string& venue, Event* event,
+                          int round, int heat, const std::vector<AthleteHandle>& entrants, const std::vector<int>* lanes) {
+    // 道次随场次保存，不依赖项目当前的分组，之后的轮次重新分组也不影响已安排的场次
+    const bool hasLanes = lanes && lanes->size() == entrants.size();
+    ScheduledSession session(day, startTime, endTime, venue, event, round, heat);
+
+    // 预先解析参赛者
+    session.roster.reserve(entrants.size());
+    for (std::size_t i = 0; i < entrants.size(); ++i) {
+        if (const Athlete* athlete = sm.getAthlete(entrants[i])) {
+            session.roster.push_back({entrants[i], athlete, athlete->unit, hasLanes ? (*lanes)[i] : 0});
+        }
+    }
+    addSession(std::move(session));
+}
+
+void Schedule::addSession(ScheduledSession added) {
+    scheduled_sessions.push_back(std::move(added));
+    const ScheduledSession& session = scheduled_sessions.back();
+    const int day = session.day;
+    const int startTime = session.startTime;
+    const int endTime = session.endTime;
+
+    // 记录场地和运动员的繁忙时段，并把场次按时间顺序插入参赛者的个人赛程
+    const std::uint32_t index = static_cast<std::uint32_t>(scheduled_sessions.size() - 1);
+    auto earlier = [this](const std::pair<int, int>& when, std::uint32_t other) {
+        const ScheduledSession& s = scheduled_sessions[other];
+        return when < std::make_pair(s.day, s.startTime);
+    };
+    venue_timelines[getVenueHandle(session.venue)].occupy(day, startTime, endTime);
+    for (const SessionEntrant& entrant : session.roster) {
+        const AthleteHandle athlete = entrant.handle;
+        if (athlete >= athlete_timelines.size()) {
+            athlete_timelines.resize(athlete + 1);
+            athlete_sessions.resize(athlete + 1);
+        }
+        athlete_timelines[athlete].occupy(day, startTime - ATHLETE_REST_MINUTES, endTime + ATHLETE_REST_MINUTES);
+        std::vector<std::uint32_t>& own = athlete_sessions[athlete];
+        own.insert(std::upper_bound(own.begin(), own.end(), std::make_pair(day, startTime), earlier), index);
+    }
+
+    if (day >= 1) {
+        if (static_cast<size_t>(day) > day_loads.size()) {
+            day_loads.resize(day);
+        }
+        DayLoad& load = day_loads[day - 1];
+        if (startTime < AFTERNOON_START) {
+            load.morningSessions++;
+        } else {
+            load.afternoonSessions++;
+        }
+        load.minutesUsed += endTime - startTime;
 
-    // 记录场地和运动员的繁忙时段
-    venue_busy_slots[venue][day].push_back({startTime, endTime});
-    // 修复：使用 event->registeredAthletes 并通过 sm.findAthlete 查找运动员
-    for (const auto& athleteId : event->registeredAthletes) {
-        Athlete* athlete = sm.findAthlete(athleteId);
-        if (athlete) {
-            // 修复：使用 athlete->id
-            athlete_busy_slots[athlete->id][day].push_back({startTime, endTime});
+        if (static_cast<size_t>(day) > day_sessions.size()) {
+            day_sessions.resize(day);
         }
+        // 多数调用方按时间顺序添加，插入位置通常就在末尾
+        std::vector<std::uint32_t>& sessions = day_sessions[day - 1];
+        auto position = std::upper_bound(sessions.begin(), sessions.end(), startTime,
+            [this](int start, std::uint32_t index) { return start < scheduled_sessions[index].startTime; });
+        sessions.insert(position, index);
+    }
+}
+
+VenueHandle Schedule::getVenueHandle(const std::string& venue) {
+    auto result = venue_handles.emplace(venue, static_cast<VenueHandle>(venue_timelines.size()));
+    if (result.second) {
+        venue_timelines.emplace_back();
+        venue_names.push_back(venue);
     }
+    return result.first->second;
 }
 
 bool Schedule::isVenueAvailable(const std::string& venue, int day, int startTime, int endTime) const {
-    if (venue_busy_slots.count(venue) && venue_busy_slots.at(venue).count(day)) {
-        for (const auto& busy_slot : venue_busy_slots.at(venue).at(day)) {
-            if (timeRangesOverlap(startTime, endTime, busy_slot.first, busy_slot.second)) {
-                return false;
+    auto it = venue_handles.find(venue);
+    return it == venue_handles.end() || isVenueAvailable(it->second, day, startTime, endTime);
+}
+
+bool Schedule::isVenueAvailable(VenueHandle venue, int day, int startTime, int endTime) const {
+    return venue >= venue_timelines.size() || venue_timelines[venue].isFree(day, startTime, endTime);
+}
+
+bool Schedule::isAthleteAvailable(const Athlete* athlete, int day, int startTime, int endTime) const {
+    // 占用已包含休息时间，与之有任何重叠（哪怕只是1分钟的休息时间）即不可用
+    return athlete->handle >= athlete_timelines.size() ||
+           athlete_timelines[athlete->handle].isFree(day, startTime, endTime);
+}
+
+DayBitmap Schedule::blockedMask(const std::vector<AthleteHandle>& entrants, VenueHandle venue, int day) const {
+    DayBitmap blocked;
+    if (venue < venue_timelines.size()) {
+        if (const DayBitmap* bitmap = venue_timelines[venue].getDay(day)) {
+            blocked |= *bitmap;
+        }
+    }
+    for (AthleteHandle athlete : entrants) {
+        if (athlete < athlete_timelines.size()) {
+            if (const DayBitmap* bitmap = athlete_timelines[athlete].getDay(day)) {
+                blocked |= *bitmap;
             }
         }
     }
-    return true;
+    return blocked;
 }
 
-bool Schedule::isAthleteAvailable(const Athlete* athlete, int day, int startTime, int endTime) const {
-    const int rest_time = 30; // 强制休息30分钟
-    // 我们要检查的带休息时间的总时间段是 [startTime - 30, endTime + 30)
-    int check_start = startTime - rest_time;
-    int check_end = endTime + rest_time;
-    
-    // 修复：使用 athlete->id
-    if (athlete_busy_slots.count(athlete->id) && athlete_busy_slots.at(athlete->id).count(day)) {
-        for (const auto& busy_slot : athlete_busy_slots.at(athlete->id).at(day)) {
-            // 检查运动员自己的比赛时间，如果和别的比赛有任何重叠（哪怕是1分钟的休息时间）
-            if (timeRangesOverlap(check_start, check_end, busy_slot.first, busy_slot.second)) {
-                return false;
+std::vector<std::uint32_t> Schedule::sessionsOf(const Event* event) const {
+    // 项目每个场次的参赛者都来自其报名名单，从这些运动员的个人赛程中即可找全
+    std::vector<std::uint32_t> found;
+    for (AthleteHandle athlete : event->registeredAthletes) {
+        if (athlete >= athlete_sessions.size()) continue;
+        for (std::uint32_t index : athlete_sessions[athlete]) {
+            if (scheduled_sessions[index].event == event) {
+                found.push_back(index);
             }
         }
     }
-    return true;
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+    return found;
+}
+
+std::vector<std::uint32_t> Schedule::sessionsOfAthletes(const std::vector<AthleteHandle>& athletes) const {
+    std::vector<std::uint32_t> found;
+    for (AthleteHandle athlete : athletes) {
+        if (athlete < athlete_sessions.size()) {
+            found.insert(found.end(), athlete_sessions[athlete].begin(), athlete_sessions[athlete].end());
+        }
+    }
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+    return found;
+}
+
+bool Schedule::sessionConflicts(std::uint32_t index) const {
+    const ScheduledSession& session = scheduled_sessions[index];
+    if (session.day < 1 || static_cast<std::size_t>(session.day) > day_sessions.size()) {
+        return false;
+    }
+    for (std::uint32_t other : day_sessions[session.day - 1]) {
+        const ScheduledSession& o = scheduled_sessions[other];
+        if (other != index && o.venue == session.venue && o.startTime < session.endTime && session.startTime < o.endTime) {
+            return true;
+        }
+    }
+    // 与位图中的占用一致：其他场次两侧各扩展休息时间后不得与本场次重叠
+    for (const SessionEntrant& entrant : session.roster) {
+        for (std::uint32_t other : athlete_sessions[entrant.handle]) {
+            const ScheduledSession& o = scheduled_sessions[other];
+            if (other != index && o.day == session.day &&
+                o.startTime - ATHLETE_REST_MINUTES < session.endTime && session.startTime < o.endTime + ATHLETE_REST_MINUTES) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void Schedule::removeSessions(std::vector<std::uint32_t> indices) {
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+    auto eraseIndex = [](std::vector<std::uint32_t>& list, std::uint32_t index) {
+        list.erase(std::find(list.begin(), list.end(), index));
+    };
+    auto replaceIndex = [](std::vector<std::uint32_t>& list, std::uint32_t from, std::uint32_t to) {
+        *std::find(list.begin(), list.end(), from) = to;
+    };
+
+    // 从大到小移除，移入空位的末尾场次一定是保留的场次
+    std::vector<std::pair<VenueHandle, int>> venueDays;
+    std::vector<std::pair<AthleteHandle, int>> athleteDays;
+    for (auto it = indices.rbegin(); it != indices.rend(); ++it) {
+        const std::uint32_t index = *it;
+        const ScheduledSession& session = scheduled_sessions[index];
+        const int day = session.day;
+        venueDays.emplace_back(venue_handles.at(session.venue), day);
+        for (const SessionEntrant& entrant : session.roster) {
+            const AthleteHandle athlete = entrant.handle;
+            eraseIndex(athlete_sessions[athlete], index);
+            athleteDays.emplace_back(athlete, day);
+        }
+        if (day >= 1) {
+            DayLoad& load = day_loads[day - 1];
+            if (session.startTime < AFTERNOON_START) {
+                load.morningSessions--;
+            } else {
+                load.afternoonSessions--;
+            }
+            load.minutesUsed -= session.endTime - session.startTime;
+            eraseIndex(day_sessions[day - 1], index);
+        }
+
+        // 末尾场次移入空位，只需改写它在当天列表和参赛者个人赛程中的下标，顺序不变
+        const std::uint32_t last = static_cast<std::uint32_t>(scheduled_sessions.size() - 1);
+        if (index != last) {
+            const ScheduledSession& moved = scheduled_sessions[last];
+            for (const SessionEntrant& entrant : moved.roster) {
+                replaceIndex(athlete_sessions[entrant.handle], last, index);
+            }
+            if (moved.day >= 1) {
+                replaceIndex(day_sessions[moved.day - 1], last, index);
+            }
+            scheduled_sessions[index] = std::move(scheduled_sessions[last]);
+        }
+        scheduled_sessions.pop_back();
+    }
+
+    // 占用位图无法按场次撤销，只重建受影响的场地日和运动员日
+    std::sort(venueDays.begin(), venueDays.end());
+    venueDays.erase(std::unique(venueDays.begin(), venueDays.end()), venueDays.end());
+    for (const auto& venueDay : venueDays) {
+        rebuildVenueDay(venueDay.first, venueDay.second);
+    }
+    std::sort(athleteDays.begin(), athleteDays.end());
+    athleteDays.erase(std::unique(athleteDays.begin(), athleteDays.end()), athleteDays.end());
+    for (const auto& athleteDay : athleteDays) {
+        rebuildAthleteDay(athleteDay.first, athleteDay.second);
+    }
+}
+
+void Schedule::removeEvent(const Event* event) {
+    removeSessions(sessionsOf(event));
+}
+
+void Schedule::rebuildVenueDay(VenueHandle venue, int day) {
+    ResourceTimeline& timeline = venue_timelines[venue];
+    timeline.clearDay(day);
+    if (day < 1 || static_cast<std::size_t>(day) > day_sessions.size()) {
+        return;
+    }
+    for (std::uint32_t index : day_sessions[day - 1]) {
+        const ScheduledSession& session = scheduled_sessions[index];
+        if (venue_handles.at(session.venue) == venue) {
+            timeline.occupy(day, session.startTime, session.endTime);
+        }
+    }
+}
+
+void Schedule::rebuildAthleteDay(AthleteHandle athlete, int day) {
+    ResourceTimeline& timeline = athlete_timelines[athlete];
+    timeline.clearDay(day);
+    for (std::uint32_t index : athlete_sessions[athlete]) {
+        const ScheduledSession& session = scheduled_sessions[index];
+        if (session.day == day) {
+            timeline.occupy(day, session.startTime - ATHLETE_REST_MINUTES, session.endTime + ATHLETE_REST_MINUTES);
+        }
+    }
+}
+
+DayLoad Schedule::getDayLoad(int day) const {
+    if (day < 1 || static_cast<size_t>(day) > day_loads.size()) {
+        return DayLoad();
+    }
+    return day_loads[day - 1];
+}
+
+std::size_t Schedule::getSessionCount(AthleteHandle athlete) const {
+    return athlete < athlete_sessions.size() ? athlete_sessions[athlete].size() : 0;
 }
 
 const std::vector<ScheduledSession>& Schedule::getFullSchedule() const {
@@ -62,6 +297,12 @@ const std::vector<ScheduledSession>& Schedule::getFullSchedule() const {
 
 void Schedule::clear() {
     scheduled_sessions.clear();
-    venue_busy_slots.clear();
-    athlete_busy_slots.clear();
+    // 场地句柄保留，只清空占用
+    for (auto& timeline : venue_timelines) {
+        timeline.clear();
+    }
+    athlete_timelines.clear();
+    athlete_sessions.clear();
+    day_loads.clear();
+    day_sessions.clear();
 } 
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include "ScheduleOptimizer.h"
+#include <cmath>
+
+ScheduleOptimizer::ScheduleOptimizer(SchedulePlan& plan, unsigned seed) : plan(plan), rng(seed) {}
+
+bool ScheduleOptimizer::relocate(std::uint32_t& node, SchedulePlan::Placement& old) {
+    node = std::uniform_int_distribution<std::uint32_t>(0, static_cast<std::uint32_t>(plan.size() - 1))(rng);
+    const std::vector<VenueHandle>& venues = plan.allowedVenues(node);
+    if (venues.empty()) {
+        return false;
+    }
+    VenueHandle venue = venues.size() == 1
+        ? venues.front()
+        : venues[std::uniform_int_distribution<std::size_t>(0, venues.size() - 1)(rng)];
+    int day = std::uniform_int_distribution<int>(1, plan.getDays())(rng);
+
+    starts.clear();
+    plan.feasibleStarts(node, venue, day, starts);
+    if (starts.empty()) {
+        return false;
+    }
+    int start = starts[std::uniform_int_distribution<std::size_t>(0, starts.size() - 1)(rng)];
+
+    SchedulePlan::Placement& p = plan.at(node);
+    if (p.venue == venue && p.day == day && p.startTime == start) {
+        return false;
+    }
+    old = p;
+    p.venue = venue;
+    p.day = day;
+    p.startTime = start;
+    return true;
+}
+
+bool ScheduleOptimizer::swap(std::uint32_t& a, std::uint32_t& b, SchedulePlan::Placement& oldA, SchedulePlan::Placement& oldB) {
+    std::uniform_int_distribution<std::uint32_t> pick(0, static_cast<std::uint32_t>(plan.size() - 1));
+    a = pick(rng);
+    b = pick(rng);
+    SchedulePlan::Placement& pa = plan.at(a);
+    SchedulePlan::Placement& pb = plan.at(b);
+    if (a == b || !pa.placed() || !pb.placed() || (pa.day == pb.day && pa.startTime == pb.startTime)) {
+        return false;
+    }
+
+    // 双方场地互相适用时连同场地交换，否则各自留在原场地只交换时间
+    oldA = pa;
+    oldB = pb;
+    const bool swapVenues = plan.venueAllowed(a, oldB.venue) && plan.venueAllowed(b, oldA.venue);
+    const VenueHandle venueA = swapVenues ? oldB.venue : oldA.venue;
+    const VenueHandle venueB = swapVenues ? oldA.venue : oldB.venue;
+
+    // 先撤下两个项目，再依次检查能否放到对方的位置
+    pa.day = -1;
+    pb.day = -1;
+    if (plan.canPlace(a, venueA, oldB.day, oldB.startTime)) {
+        pa.venue = venueA;
+        pa.day = oldB.day;
+        pa.startTime = oldB.startTime;
+        if (plan.canPlace(b, venueB, oldA.day, oldA.startTime)) {
+            pb.venue = venueB;
+            pb.day = oldA.day;
+            pb.startTime = oldA.startTime;
+            return true;
+        }
+    }
+    pa = oldA;
+    pb = oldB;
+    return false;
+}
+
+ScheduleOptimizer::Stats ScheduleOptimizer::run(std::chrono::milliseconds budget, long maxIterations) {
+    Stats stats;
+    stats.before = plan.evaluate();
+    stats.after = stats.before;
+    if (plan.size() == 0 || maxIterations <= 0) {
+        return stats;
+    }
+
+    const double startTemperature = 1000.0;
+    const double endTemperature = 1.0;
+    const auto begin = std::chrono::steady_clock::now();
+
+    long current = stats.before.total();
+    long best = current;
+    std::vector<SchedulePlan::Placement> bestPlacements;
+    auto saveBest = [this, &bestPlacements]() {
+        bestPlacements = plan.getPlacements();
+    };
+    saveBest();
+
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double progress = 0.0;
+    for (long iteration = 0; iteration < maxIterations; ++iteration) {
+        // 每 64 次检查一次时钟，进度取时间与迭代两者中较快的一个
+        if ((iteration & 63) == 0) {
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            if (elapsed >= static_cast<double>(budget.count())) {
+                break;
+            }
+            progress = std::max(static_cast<double>(iteration) / maxIterations,
+                                budget.count() > 0 ? elapsed / budget.count() : 1.0);
+        }
+        const double temperature = startTemperature * std::pow(endTemperature / startTemperature, progress);
+        stats.iterations++;
+
+        std::uint32_t a = 0, b = 0;
+        SchedulePlan::Placement oldA{}, oldB{};
+        const bool isSwap = unit(rng) < 0.3;
+        if (isSwap ? !swap(a, b, oldA, oldB) : !relocate(a, oldA)) {
+            continue;
+        }
+
+        long candidate = plan.evaluate().total();
+        long delta = candidate - current;
+        if (delta <= 0 || unit(rng) < std::exp(-static_cast<double>(delta) / temperature)) {
+            current = candidate;
+            stats.accepted++;
+            if (current < best) {
+                best = current;
+                saveBest();
+            }
+            continue;
+        }
+
+        // 拒绝：撤销移动
+        plan.at(a) = oldA;
+        if (isSwap) {
+            plan.at(b) = oldB;
+        }
+    }
+
+    for (std::uint32_t node = 0; node < plan.size(); ++node) {
+        plan.at(node) = bestPlacements[node];
+    }
+    stats.after = plan.evaluate();
+    stats.elapsedMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    return stats;
+}
@@ -0,0 +1,258 @@
+#include "SchedulePlan.h"
+#include "Event.h"
+#include "Schedule.h"
+#include <algorithm>
+#include <cstdlib>
+
+SchedulePlan::SchedulePlan(int days, std::vector<std::pair<int, int>> windows, int timeStep)
+    : days(days), windows(std::move(windows)), timeStep(std::max(timeStep, 1)) {}
+
+void SchedulePlan::addUnit(const ScheduleUnit& unit, std::vector<VenueHandle> allowed, VenueHandle venue, int day, int startTime) {
+    Placement placement{unit.event, venue, day, startTime, unit.durationMinutes, unit.heat, unit.entrants, unit.round, unit.lanes};
+    if (!placement.placed()) {
+        placement.startTime = -1;
+    }
+    placements.push_back(placement);
+    venueOptions.push_back(std::move(allowed));
+    earliest.emplace_back(1, 0);
+}
+
+void SchedulePlan::addFixed(FixedSession session) {
+    fixedSessions.push_back(std::move(session));
+}
+
+void SchedulePlan::setEarliestStart(std::uint32_t node, int day, int minute) {
+    earliest[node] = {day, minute};
+}
+
+int SchedulePlan::lastConstrainedDay() const {
+    int last = 0;
+    for (const FixedSession& fixed : fixedSessions) {
+        last = std::max(last, fixed.day);
+    }
+    for (const auto& ready : earliest) {
+        if (ready.first > 1 || ready.second > 0) {
+            last = std::max(last, ready.first);
+        }
+    }
+    return last;
+}
+
+void SchedulePlan::finalize() {
+    std::vector<ScheduleUnit> units;
+    units.reserve(placements.size());
+    venueMembers.clear();
+    for (std::uint32_t node = 0; node < placements.size(); ++node) {
+        const Placement& p = placements[node];
+        units.push_back({p.event, p.heat, p.entrants, p.duration, p.round, p.lanes});
+        // 已有安排的场地可能已不在可用列表中，也要登记以便其他场次避开它
+        std::vector<VenueHandle> touched = venueOptions[node];
+        if (p.venue != INVALID_HANDLE) {
+            touched.push_back(p.venue);
+        }
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        for (VenueHandle venue : touched) {
+            if (venue >= venueMembers.size()) {
+                venueMembers.resize(venue + 1);
+            }
+            venueMembers[venue].push_back(node);
+        }
+    }
+    conflicts.build(units);
+
+    // 固定场次按场地和参赛者建立索引，安排其他场次时一并避开
+    fixedByVenue.clear();
+    std::vector<std::vector<std::uint32_t>> fixedOfAthlete;
+    for (std::uint32_t index = 0; index < fixedSessions.size(); ++index) {
+        const FixedSession& fixed = fixedSessions[index];
+        if (fixed.venue != INVALID_HANDLE) {
+            if (fixed.venue >= fixedByVenue.size()) {
+                fixedByVenue.resize(fixed.venue + 1);
+            }
+            fixedByVenue[fixed.venue].push_back(index);
+        }
+        for (AthleteHandle athlete : fixed.entrants) {
+            if (athlete >= fixedOfAthlete.size()) {
+                fixedOfAthlete.resize(athlete + 1);
+            }
+            fixedOfAthlete[athlete].push_back(index);
+        }
+    }
+    fixedNeighbors.assign(placements.size(), {});
+    for (std::uint32_t node = 0; node < placements.size(); ++node) {
+        std::vector<std::uint32_t>& neighbors = fixedNeighbors[node];
+        for (AthleteHandle athlete : *placements[node].entrants) {
+            if (athlete < fixedOfAthlete.size()) {
+                neighbors.insert(neighbors.end(), fixedOfAthlete[athlete].begin(), fixedOfAthlete[athlete].end());
+            }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
+}
+
+bool SchedulePlan::venueAllowed(std::uint32_t node, VenueHandle venue) const {
+    const std::vector<VenueHandle>& allowed = venueOptions[node];
+    return std::find(allowed.begin(), allowed.end(), venue) != allowed.end();
+}
+
+DayBitmap SchedulePlan::blockedMask(std::uint32_t node, VenueHandle venue, int day) const {
+    DayBitmap blocked;
+    const std::pair<int, int>& ready = earliest[node];
+    if (day < ready.first) {
+        blocked.occupy(0, MINUTES_PER_DAY);
+        return blocked;
+    }
+    if (day == ready.first) {
+        blocked.occupy(0, ready.second);
+    }
+    for (std::uint32_t index : fixedNeighbors[node]) {
+        const FixedSession& fixed = fixedSessions[index];
+        if (fixed.day == day) {
+            blocked.occupy(fixed.startTime - Schedule::ATHLETE_REST_MINUTES, fixed.endTime + Schedule::ATHLETE_REST_MINUTES);
+        }
+    }
+    if (venue < fixedByVenue.size()) {
+        for (std::uint32_t index : fixedByVenue[venue]) {
+            const FixedSession& fixed = fixedSessions[index];
+            if (fixed.day == day) {
+                blocked.occupy(fixed.startTime, fixed.endTime);
+            }
+        }
+    }
+    for (std::uint32_t other : conflicts.neighbors(node)) {
+        const Placement& p = placements[other];
+        if (p.day == day) {
+            blocked.occupy(p.startTime - Schedule::ATHLETE_REST_MINUTES, p.endTime() + Schedule::ATHLETE_REST_MINUTES);
+        }
+    }
+    if (venue < venueMembers.size()) {
+        for (std::uint32_t other : venueMembers[venue]) {
+            const Placement& p = placements[other];
+            if (other != node && p.day == day && p.venue == venue) {
+                blocked.occupy(p.startTime, p.endTime());
+            }
+        }
+    }
+    return blocked;
+}
+
+void SchedulePlan::feasibleStarts(std::uint32_t node, VenueHandle venue, int day, std::vector<int>& starts) const {
+    DayBitmap blocked = blockedMask(node, venue, day);
+    for (const auto& window : windows) {
+        blocked.collectFreeStarts(window.first, window.second, placements[node].duration, timeStep, starts);
+    }
+}
+
+bool SchedulePlan::fitsWindow(int startTime, int duration) const {
+    for (const auto& window : windows) {
+        if (startTime >= window.first && startTime + duration <= window.second &&
+            (startTime - window.first) % timeStep == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int SchedulePlan::windowIndex(int startTime) const {
+    for (std::size_t i = 0; i < windows.size(); ++i) {
+        if (startTime >= windows[i].first && startTime < windows[i].second) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool SchedulePlan::canPlace(std::uint32_t node, VenueHandle venue, int day, int startTime) const {
+    int duration = placements[node].duration;
+    return day >= 1 && day <= days && venueAllowed(node, venue) && fitsWindow(startTime, duration) &&
+           blockedMask(node, venue, day).isFree(startTime, startTime + duration);
+}
+
+bool SchedulePlan::placementValid(std::uint32_t node) const {
+    const Placement& p = placements[node];
+    if (!p.placed() || p.day < 1 || p.day > days || !venueAllowed(node, p.venue)) {
+        return false;
+    }
+    bool inWindow = std::any_of(windows.begin(), windows.end(), [&p](const std::pair<int, int>& window) {
+        return p.startTime >= window.first && p.endTime() <= window.second;
+    });
+    return inWindow && blockedMask(node, p.venue, p.day).isFree(p.startTime, p.endTime());
+}
+
+SchedulePlan::Objective SchedulePlan::evaluate() const {
+    Objective objective;
+    std::vector<int> morning(days + 1, 0);
+    std::vector<int> afternoon(days + 1, 0);
+    // (场地, 天, 开始, 结束)，排序后按场地和天分组计算空闲
+    std::vector<std::pair<std::pair<VenueHandle, int>, std::pair<int, int>>> slots;
+    slots.reserve(placements.size() + fixedSessions.size());
+
+    // 固定场次同样计入天数、上下午分布和场地空闲
+    for (const FixedSession& fixed : fixedSessions) {
+        if (fixed.day < 1 || fixed.day > days) continue;
+        objective.daysUsed = std::max(objective.daysUsed, fixed.day);
+        if (fixed.startTime < Schedule::AFTERNOON_START) morning[fixed.day]++;
+        else afternoon[fixed.day]++;
+        slots.push_back({{fixed.venue, fixed.day}, {fixed.startTime, fixed.endTime}});
+    }
+    for (const Placement& p : placements) {
+        if (!p.placed()) {
+            objective.unscheduled++;
+            continue;
+        }
+        objective.daysUsed = std::max(objective.daysUsed, p.day);
+        if (p.startTime < Schedule::AFTERNOON_START) morning[p.day]++;
+        else afternoon[p.day]++;
+        slots.push_back({{p.venue, p.day}, {p.startTime, p.endTime()}});
+    }
+    for (int day = 1; day <= days; ++day) {
+        objective.imbalance += std::abs(morning[day] - afternoon[day]);
+    }
+
+    std::sort(slots.begin(), slots.end());
+    for (std::size_t i = 1; i < slots.size(); ++i) {
+        if (slots[i].first != slots[i - 1].first) continue;
+        // 只统计同一时间窗口内的空闲，窗口之间的休息时段不计
+        if (windowIndex(slots[i].second.first) != windowIndex(slots[i - 1].second.first)) continue;
+        int gap = slots[i].second.first - slots[i - 1].second.second;
+        objective.idleVenueMinutes += std::max(gap, 0);
+    }
+    return objective;
+}
+
+void SchedulePlan::commit(Schedule& schedule) const {
+    // 固定场次与已安排的场次一起按天和开始时间写回，固定场次在前
+    struct Entry {
+        int day;
+        int startTime;
+        const FixedSession* fixed;
+        const Placement* placement;
+    };
+    std::vector<Entry> ordered;
+    for (const FixedSession& fixed : fixedSessions) {
+        ordered.push_back({fixed.day, fixed.startTime, &fixed, nullptr});
+    }
+    for (const Placement& p : placements) {
+        if (p.placed()) {
+            ordered.push_back({p.day, p.startTime, nullptr, &p});
+        }
+    }
+    std::stable_sort(ordered.begin(), ordered.end(), [](const Entry& a, const Entry& b) {
+        if (a.day != b.day) return a.day < b.day;
+        return a.startTime < b.startTime;
+    });
+
+    schedule.clear();
+    for (const Entry& entry : ordered) {
+        if (const FixedSession* f = entry.fixed) {
+            schedule.addSession(f->day, f->startTime, f->endTime, schedule.getVenueName(f->venue), f->event,
+                                f->round, f->heat, f->entrants, &f->lanes);
+        } else {
+            const Placement* p = entry.placement;
+            schedule.addSession(p->day, p->startTime, p->endTime(), schedule.getVenueName(p->venue), p->event,
+                                p->round, p->heat, *p->entrants, p->lanes);
+        }
+    }
+}
@@ -6,6 +6,13 @@
 #include "ScoringRule.h"
 #include "BackupData.h"
 #include "Gender.h"
+#include "TimeUtils.h"
+#include "ConflictGraph.h"
+#include "ThreadPool.h"
+#include "ScheduleOptimizer.h"
+#include "HeatAllocator.h"
+#include "RoundQualifier.h"
+#include "MinimumDaysSearch.h"
 #include <iostream>
 #include <algorithm>
 #include <fstream>
@@ -15,6 +22,8 @@
 #include <sstream>
 #include <limits> // 添加此行以支持 std::numeric_limits
 #include <chrono>
+#include <tuple>
+#include <deque>
 
 SportsMeet::SportsMeet() : 
     schedule(*this),  // 正确初始化Schedule
@@ -24,10 +33,16 @@ SportsMeet::SportsMeet() :
     morningStartTime(8 * 60),  // 8:00 AM
     morningEndTime(12 * 60),   // 12:00 PM
     afternoonStartTime(14 * 60), // 2:00 PM
-    afternoonEndTime(18 * 60)   // 6:00 PM
+    afternoonEndTime(18 * 60),  // 6:00 PM
+    scheduleTimeStep(DEFAULT_TIME_STEP), // 以15分钟为步长安排开始时间
+    scheduleThreads(1)          // 默认串行排程
 {
-    venues.push_back("主场");
-    venues.push_back("副场");
+    // 默认场地：一块八道跑道，跳跃区与投掷区各一块，另有一块可兼作跳跃和投掷的副场，
+    // 不同场地上的田赛项目可以同时进行
+    venues.emplace_back("主场", VENUE_TRACK, 8);
+    venues.emplace_back("跳跃场", VENUE_JUMPS);
+    venues.emplace_back("投掷场", VENUE_THROWS);
+    venues.emplace_back("副场", VENUE_JUMPS | VENUE_THROWS);
     
     // 添加默认计分规则 - 使用正确的构造函数
     std::vector<SubRule> standardRules;
@@ -51,6 +66,93 @@ void SportsMeet::setCompetitionDays(int days) {
     competitionDays = days;
 }
 
+void SportsMeet::setScheduleTimeStep(int minutes) {
+    if (minutes < MIN_TIME_STEP || minutes > MAX_TIME_STEP) {
+        std::cout << "错误：排程时间步长必须在1-60分钟之间。\n";
+        return;
+    }
+    scheduleTimeStep = minutes;
+    std::cout << "排程时间步长已设置为 " << minutes << " 分钟。\n";
+}
+
+void SportsMeet::setScheduleThreads(int threads) {
+    if (threads < 1 || threads > 64) {
+        std::cout << "错误：排程线程数必须在1-64之间。\n";
+        return;
+    }
+    scheduleThreads = threads;
+    // 线程池在各次排程间复用，只在这里按新的线程数重建
+    schedulePool.reset();
+    if (threads > 1) {
+        schedulePool = std::make_unique<ThreadPool>(static_cast<unsigned>(threads));
+    }
+    std::cout << "排程线程数已设置为 " << threads << (threads == 1 ? "（串行）" : "") << "。\n";
+}
+
+void SportsMeet::addVenue(const std::string& name, unsigned capabilities, int lanes) {
+    if (name.empty()) {
+        std::cout << "错误：场地名称不能为空。\n";
+        return;
+    }
+    if (std::any_of(venues.begin(), venues.end(), [&name](const Venue& venue) { return venue.name == name; })) {
+        std::cout << "错误：场地 '" << name << "' 已存在。\n";
+        return;
+    }
+    capabilities &= VENUE_TRACK | VENUE_JUMPS | VENUE_THROWS;
+    if (capabilities == 0) {
+        std::cout << "错误：场地至少需要支持一种项目类别。\n";
+        return;
+    }
+    if (capabilities & VENUE_TRACK) {
+        if (lanes < 1) {
+            std::cout << "错误：径赛场地至少需要1条跑道。\n";
+            return;
+        }
+    } else {
+        lanes = 0;
+    }
+    venues.emplace_back(name, capabilities, lanes);
+    std::cout << "场地 '" << name << "' 添加成功！\n";
+}
+
+void SportsMeet::removeVenue(const std::string& name) {
+    auto it = std::find_if(venues.begin(), venues.end(), [&name](const Venue& venue) { return venue.name == name; });
+    if (it == venues.end()) {
+        std::cout << "错误：未找到场地 '" << name << "'。\n";
+        return;
+    }
+    venues.erase(it);
+    // 该场地上的场次在修复时重新安排
+    for (const auto& session : schedule.getFullSchedule()) {
+        if (session.venue == name) {
+            noteScheduleChange(session.event);
+        }
+    }
+    std::cout << "场地 '" << name << "' 已删除，重新生成或修复秩序册后生效。\n";
+}
+
+void SportsMeet::showVenues() const {
+    std::cout << "\n--- 场地列表 ---\n";
+    if (venues.empty()) {
+        std::cout << "暂无场地。\n";
+        return;
+    }
+    for (const Venue& venue : venues) {
+        std::cout << "- " << venue.name << "：";
+        const char* separator = "";
+        for (Discipline discipline : {Discipline::TRACK, Discipline::JUMPS, Discipline::THROWS}) {
+            if (venue.supports(discipline)) {
+                std::cout << separator << disciplineToString(discipline);
+                separator = "、";
+            }
+        }
+        if (venue.lanes > 0) {
+            std::cout << "，" << venue.lanes << " 条跑道";
+        }
+        std::cout << "\n";
+    }
+}
+
 void SportsMeet::setMorningTimeWindow(int startHour, int startMinute, int endHour, int endMinute) {
     // 检查时间格式有效性
     if (startHour < 0 || startHour > 23 || startMinute < 0 || startMinute > 59 ||
@@ -121,7 +223,7 @@ void SportsMeet::setAfternoonTimeWindow(int startHour, int startMinute, int endH
 
 void SportsMeet::addUnit(const std::string& unitName) {
     if (!findUnit(unitName)) {
-        units.emplace_back(std::make_unique<Unit>(unitName));
+        units.push_back(unitPool.make(unitName, &athletePool));
         std::cout << "单位 '" << unitName << "' 添加成功！\n";
     } else {
         std::cout << "错误: 单位 '" << unitName << "' 已存在。\n";
@@ -131,11 +233,16 @@ void SportsMeet::addUnit(const std::string& unitName) {
 void SportsMeet::addAthleteToUnit(const std::string& unitName, const std::string& athleteId, const std::string& athleteName, Gender gender) {
     Unit* unit = findUnit(unitName);
     if (unit) {
-        unit->addAthlete(athleteId, athleteName, gender);
+        if (athleteIndex.count(athleteId)) {
+            std::cout << "错误: 学号为 " << athleteId << " 的运动员已存在。\n";
+            return;
+        }
+        auto unitIt = std::find_if(units.begin(), units.end(), [&](const PoolPtr<Unit>& u) { return u.get() == unit; });
+        indexAthlete(unit->addAthlete(athleteId, athleteName, gender),
+                     static_cast<std::uint32_t>(unitIt - units.begin()));
         std::cout << "运动员 '" << athleteName << "' 已添加到单位 '" << unitName << "'。\n";
         
-        // 标记查询数据结构需要重新初始化
-        isHashMapInitialized = false;
+        // 学号索引已就地更新，仅演示用的排序数组需要重建
         isSortedVectorInitialized = false;
     } else {
         std::cout << "错误: 未找到单位 '" << unitName << "'。\n";
@@ -143,33 +250,58 @@ void SportsMeet::addAthleteToUnit(const std::string& unitName, const std::string
 }
 
 void SportsMeet::addEvent(const std::string& name, Gender gender, bool isTimeBased, const ScoringRule& rule, int durationMinutes) {
+    addEvent(name, gender, isTimeBased, inferDiscipline(name, isTimeBased), rule, durationMinutes);
+}
+
+void SportsMeet::addEvent(const std::string& name, Gender gender, bool isTimeBased, Discipline discipline, const ScoringRule& rule, int durationMinutes) {
     if (findEvent(name, gender)) {
         std::cout << "错误: 项目 '" << name << "' (" << genderToString(gender) << ") 已存在。\n";
         return;
     }
-    events.emplace_back(std::make_unique<Event>(name, gender, isTimeBased, rule, durationMinutes));
+    events.push_back(eventPool.make(name, gender, isTimeBased, discipline, rule, durationMinutes));
+    indexEvent(events.back().get());
     std::cout << "项目 '" << name << "' 添加成功！\n";
 }
 
 void SportsMeet::deleteEvent(const std::string& eventName, Gender gender) {
-    auto it = std::remove_if(events.begin(), events.end(), [&](const std::unique_ptr<Event>& event) {
-        return event->name == eventName && event->gender == gender;
-    });
-
-    if (it != events.end()) {
-        for (auto& unit : units) {
-            for (auto& athlete : unit->athletes) {
-                athlete->unregisterFromEvent(eventName);
+    Event* target = findEvent(eventName, gender);
+
+    if (target) {
+        EventHandle handle = target->handle;
+        // 调用方可能直接传入 target->name，删除前先复制一份用于提示
+        const std::string deletedName = target->name;
+        registrations.clearEvent(handle, target->registeredAthletes);
+        for (const auto& result : target->results) {
+            if (Athlete* athlete = getAthlete(result.athlete)) {
+                // 与重复计分时一样，先撤销该项目已计入运动员及单位的得分
+                if (result.rank > 0) {
+                    awardPoints(athlete, -result.points);
+                }
+                athlete->removeResultRefs(handle);
+                athlete->unit->removePlacings(handle);
             }
         }
-        events.erase(it, events.end());
-        std::cout << "项目 '" << eventName << "' 已被删除。\n";
+        // 只访问该项目报名名单上的运动员，代价与报名人数成正比
+        for (AthleteHandle entrant : target->registeredAthletes) {
+            if (Athlete* athlete = getAthlete(entrant)) {
+                athlete->unregisterFromEvent(handle);
+                athleteTable.registrationCounts[entrant]--;
+            }
+        }
+        schedule.removeEvent(target);
+        // 句柄释放后可能被新项目复用，删除前撤销待修复记录
+        scheduleChanges.erase(std::remove(scheduleChanges.begin(), scheduleChanges.end(), handle), scheduleChanges.end());
+        unindexEvent(target);
+        events.erase(std::find_if(events.begin(), events.end(), [&](const PoolPtr<Event>& event) {
+            return event.get() == target;
+        }));
+        std::cout << "项目 '" << deletedName << "' 已被删除。\n";
     } else {
         std::cout << "未找到要删除的项目。\n";
     }
 }
 
-void SportsMeet::registerAthleteForEvent(const std::string& athleteId, const std::string& eventName, Gender eventGender) {
+void SportsMeet::registerAthleteForEvent(const std::string& athleteId, const std::string& eventName, Gender eventGender, double entryMark) {
     Athlete* athlete = findAthlete(athleteId);
     if (!athlete) {
         std::cout << "错误: 未找到学号为 " << athleteId << " 的运动员。\n";
@@ -182,26 +314,32 @@ void SportsMeet::registerAthleteForEvent(const std::string& athleteId, const std
         return;
     }
 
-    // 使用Event的allowsGender方法检查性别要求
-    if (!event->allowsGender(athlete->gender)) {
+    // 性别与报名项目数从列式表读取
+    const AthleteHandle row = athlete->handle;
+    if (!genderAllowed(athleteTable.genders[row], event->gender)) {
         std::cout << "错误: 运动员性别 (" << genderToString(athlete->gender) << ") 与项目要求性别 (" 
                   << genderToString(event->gender) << ") 不符。\n";
         return;
     }
 
-    if (!athlete->canRegister(maxEventsPerAthlete)) {
+    if (athleteTable.registrationCounts[row] >= maxEventsPerAthlete) {
         std::cout << "错误: 运动员 " << athlete->name << " 报名项目已达上限 (" << maxEventsPerAthlete << ")。\n";
         return;
     }
 
-    if (athlete->isRegisteredFor(event->name)) {
+    if (registrations.test(athlete->handle, event->handle)) {
         std::cout << "错误: 运动员 " << athlete->name << " 已报名参加项目 '" << event->name << "'。\n";
         return;
     }
 
-    athlete->registerForEvent(event->name);
-    event->addAthlete(athlete->id);
-    std::cout << "运动员 " << athlete->name << " 成功报名参加项目 '" << event->name << "'。\n";
+    linkRegistration(athlete, event);
+    event->setEntryMark(athlete->handle, entryMark);
+    noteScheduleChange(event);
+    std::cout << "运动员 " << athlete->name << " 成功报名参加项目 '" << event->name << "'";
+    if (entryMark > 0) {
+        std::cout << "，报名成绩 " << entryMark;
+    }
+    std::cout << "。\n";
 }
 
 void SportsMeet::recordResult(const std::string& eventName, Gender eventGender, const std::string& athleteId, double performance) {
@@ -215,10 +353,18 @@ void SportsMeet::recordResult(const std::string& eventName, Gender eventGender,
         std::cout << "错误: 未找到运动员。\n";
         return;
     }
+    if (!event->inFinalRound()) {
+        recordRoundResult(event, athlete, performance);
+        return;
+    }
+    const std::vector<AthleteHandle>& entrants = event->roundEntrants();
+    if (!event->rounds.empty() && std::find(entrants.begin(), entrants.end(), athlete->handle) == entrants.end()) {
+        std::cout << "错误: 运动员 " << athlete->name << " 未进入项目 '" << eventName << "' 的" << event->roundName(event->currentRound) << "。\n";
+        return;
+    }
 
-    // 使用 eventName + "_" + genderToString(eventGender) 作为键
-    Result result(athleteId, performance);
-    eventResults[eventName + "_" + genderToString(eventGender)].push_back(result);
+    athlete->results.push_back({event->handle, static_cast<std::uint32_t>(event->results.size())});
+    event->results.emplace_back(athlete->handle, performance);
     std::cout << "已记录 " << athlete->name << " 在项目 '" << eventName << "' 的成绩: " << performance << "\n";
 }
 
@@ -228,8 +374,12 @@ void SportsMeet::showAllUnits() const {
         std::cout << "没有单位信息。\n";
         return;
     }
+    // 总分与人数各由一次列扫描按单位汇总
+    std::vector<int> scoreTotals = athleteTable.scoreTotalsByUnit(units.size());
+    std::vector<int> athleteCounts = athleteTable.countByUnit(units.size());
     for (size_t i = 0; i < units.size(); ++i) {
-        std::cout << i + 1 << ". " << units[i]->name << " (总分: " << units[i]->score << ")\n";
+        std::cout << i + 1 << ". " << units[i]->name << " (总分: " << scoreTotals[i]
+                  << ", 运动员: " << athleteCounts[i] << "人)\n";
     }
 }
 
@@ -253,29 +403,30 @@ void SportsMeet::showAllEvents() const {
 
 void SportsMeet::showAllAthletes() const {
     std::cout << "\n--- 所有运动员列表 ---\n";
-    bool foundAny = false;
-    for (const auto& unit : units) {
-        if (!unit->athletes.empty()) {
-            foundAny = true;
-            std::cout << "--- 单位: " << unit->name << " ---\n";
-            for (const auto& athlete : unit->athletes) {
-                std::cout << "  - ID: " << athlete->id
-                          << ", 姓名: " << athlete->name
-                          << ", 性别: " << genderToString(athlete->gender) << "\n";
-            }
-        }
+    if (athleteTable.size() == 0) {
+        std::cout << "系统中没有运动员信息。\n";
+        return;
     }
 
-    if (!foundAny) {
-        std::cout << "系统中没有运动员信息。\n";
+    // 一次遍历单位列按单位归集行，再从列式表中读取要显示的字段
+    std::vector<std::vector<AthleteHandle>> rowsByUnit = athleteTable.bucketByUnit(units.size());
+    for (std::uint32_t unitIndex = 0; unitIndex < units.size(); ++unitIndex) {
+        const std::vector<AthleteHandle>& rows = rowsByUnit[unitIndex];
+        if (rows.empty()) continue;
+        std::cout << "--- 单位: " << units[unitIndex]->name << " ---\n";
+        for (AthleteHandle row : rows) {
+            std::cout << "  - ID: " << athleteTable.ids[row]
+                      << ", 姓名: " << athleteTable.names[row]
+                      << ", 性别: " << genderToString(athleteTable.genders[row]) << "\n";
+        }
     }
 }
 
-const std::vector<std::unique_ptr<Event>>& SportsMeet::getAllEvents() const {
+const std::vector<PoolPtr<Event>>& SportsMeet::getAllEvents() const {
     return events;
 }
 
-const std::vector<std::unique_ptr<Unit>>& SportsMeet::getAllUnits() const {
+const std::vector<PoolPtr<Unit>>& SportsMeet::getAllUnits() const {
     return units;
 }
 
@@ -294,24 +445,86 @@ const Unit* SportsMeet::findUnit(const std::string& unitName) const {
 }
 
 Event* SportsMeet::findEvent(const std::string& eventName, Gender gender) {
-    for (auto& event : events) {
-        if (event->name == eventName && event->gender == gender) {
-            return event.get();
+    auto it = eventIndex.find(eventName);
+    return (it != eventIndex.end()) ? it->second[static_cast<int>(gender)] : nullptr;
+}
+
+const Event* SportsMeet::findEvent(const std::string& eventName, Gender gender) const {
+    auto it = eventIndex.find(eventName);
+    return (it != eventIndex.end()) ? it->second[static_cast<int>(gender)] : nullptr;
+}
+
+bool SportsMeet::indexAthlete(Athlete* athlete, std::uint32_t unitIndex) {
+    if (!athleteIndex.emplace(athlete->id, athlete).second) {
+        return false;
+    }
+    athlete->handle = athleteHandles.add(athlete);
+    athleteTable.addRow(athlete->handle, athlete->id, athlete->name, athlete->gender, unitIndex, athlete->score);
+    return true;
+}
+
+void SportsMeet::awardPoints(Athlete* athlete, int points) {
+    athlete->score += points;
+    athlete->unit->addScore(points);
+    athleteTable.scores[athlete->handle] += points;
+}
+
+void SportsMeet::linkRegistration(Athlete* athlete, Event* event) {
+    // 位矩阵已保证不重复，直接追加，避免两侧列表的线性查重
+    registrations.set(athlete->handle, event->handle);
+    athlete->registeredEvents.push_back(event->handle);
+    event->registeredAthletes.push_back(athlete->handle);
+    athleteTable.registrationCounts[athlete->handle]++;
+}
+
+void SportsMeet::indexEvent(Event* event) {
+    auto it = eventIndex.find(event->name);
+    if (it == eventIndex.end()) {
+        it = eventIndex.emplace(event->name, std::array<Event*, GENDER_COUNT>{}).first;
+    }
+    it->second[static_cast<int>(event->gender)] = event;
+    event->handle = eventHandles.add(event);
+}
+
+void SportsMeet::unindexEvent(Event* event) {
+    auto it = eventIndex.find(event->name);
+    if (it != eventIndex.end()) {
+        auto& slots = it->second;
+        slots[static_cast<int>(event->gender)] = nullptr;
+        if (std::all_of(slots.begin(), slots.end(), [](const Event* e) { return e == nullptr; })) {
+            eventIndex.erase(it);
         }
     }
-    return nullptr;
+    eventHandles.release(event->handle);
 }
 
-const Event* SportsMeet::findEvent(const std::string& eventName, Gender gender) const {
-    for (const auto& event : events) {
-        if (event->name == eventName && event->gender == gender) {
-            return event.get();
+void SportsMeet::indexEventResults(Event* event) {
+    for (const auto& result : event->results) {
+        if (Athlete* athlete = getAthlete(result.athlete)) {
+            athlete->removeResultRefs(event->handle);
         }
     }
-    return nullptr;
+    for (std::uint32_t i = 0; i < event->results.size(); ++i) {
+        if (Athlete* athlete = getAthlete(event->results[i].athlete)) {
+            athlete->results.push_back({event->handle, i});
+        }
+    }
+}
+
+Athlete* SportsMeet::getAthlete(AthleteHandle handle) const {
+    return athleteHandles.get(handle);
+}
+
+Event* SportsMeet::getEvent(EventHandle handle) const {
+    return eventHandles.get(handle);
 }
 
 Athlete* SportsMeet::findAthlete(const std::string& athleteId) const {
+    auto it = athleteIndex.find(athleteId);
+    return (it != athleteIndex.end()) ? it->second : nullptr;
+}
+
+Athlete* SportsMeet::findAthleteLinear(const std::string& athleteId) const {
     for (const auto& unit : units) {
         if (auto* athlete = unit->findAthlete(athleteId)) {
             return athlete;
@@ -321,25 +534,60 @@ Athlete* SportsMeet::findAthlete(const std::string& athleteId) const {
 }
 
 void SportsMeet::showUnitDetails(const std::string& unitName) const {
-    const Unit* unit = findUnit(unitName);
-    if (unit) {
-        std::cout << "\n--- 单位详情: " << unit->name << " ---\n";
-        std::cout << "总分: " << unit->score << "\n";
-        std::cout << "运动员列表 (" << unit->athletes.size() << "人):\n";
-        for (const auto& athlete : unit->athletes) {
-            std::cout << "  - " << athlete->name << " (ID: " << athlete->id << ", 性别: " << genderToString(athlete->gender) << ")\n";
-            std::cout << "    个人得分: " << athlete->score << "\n";
-            std::cout << "    已报名项目 (" << athlete->registeredEvents.size() << "):\n";
-            if (athlete->registeredEvents.empty()) {
-                std::cout << "      - 无\n";
-            } else {
-                for (const auto& eventName : athlete->registeredEvents) {
-                    std::cout << "      - " << eventName << "\n";
-                }
+    auto unitIt = std::find_if(units.begin(), units.end(), [&](const PoolPtr<Unit>& u) { return u->name == unitName; });
+    if (unitIt == units.end()) {
+        std::cout << "未找到单位: " << unitName << "\n";
+        return;
+    }
+
+    // 从列式表筛选本单位的行，总分由得分列求和
+    std::vector<AthleteHandle> rows = athleteTable.selectByUnit(static_cast<std::uint32_t>(unitIt - units.begin()));
+    int total = 0;
+    for (AthleteHandle row : rows) {
+        total += athleteTable.scores[row];
+    }
+    std::cout << "\n--- 单位详情: " << (*unitIt)->name << " ---\n";
+    std::cout << "总分: " << total << "\n";
+    std::cout << "运动员列表 (" << rows.size() << "人):\n";
+    for (AthleteHandle row : rows) {
+        std::cout << "  - " << athleteTable.names[row] << " (ID: " << athleteTable.ids[row]
+                  << ", 性别: " << genderToString(athleteTable.genders[row]) << ")\n";
+        std::cout << "    个人得分: " << athleteTable.scores[row] << "\n";
+        std::cout << "    已报名项目 (" << athleteTable.registrationCounts[row] << "):\n";
+        if (athleteTable.registrationCounts[row] == 0) {
+            std::cout << "      - 无\n";
+            continue;
+        }
+        for (EventHandle eventHandle : getAthlete(row)->registeredEvents) {
+            if (const Event* event = getEvent(eventHandle)) {
+                std::cout << "      - " << event->name << "\n";
             }
         }
-    } else {
-        std::cout << "未找到单位: " << unitName << "\n";
+    }
+}
+
+void SportsMeet::showEligibleAthletes(const std::string& eventName, Gender gender) const {
+    const Event* event = findEvent(eventName, gender);
+    if (!event) {
+        std::cout << "未找到项目 '" << eventName << "' (" << genderToString(gender) << ")。\n";
+        return;
+    }
+
+    // 性别与报名项目数的筛选只扫描列式表的两列，已报名的由位矩阵排除
+    std::vector<AthleteHandle> rows = athleteTable.selectEligible(event->gender, maxEventsPerAthlete);
+    rows.erase(std::remove_if(rows.begin(), rows.end(), [&](AthleteHandle row) {
+        return registrations.test(row, event->handle);
+    }), rows.end());
+
+    std::cout << "\n--- 可报名项目 '" << event->name << "' (" << genderToString(event->gender) << ") 的运动员 ---\n";
+    if (rows.empty()) {
+        std::cout << "没有可报名的运动员。\n";
+        return;
+    }
+    for (AthleteHandle row : rows) {
+        std::cout << "  - " << athleteTable.ids[row] << " " << athleteTable.names[row]
+                  << " (" << units[athleteTable.unitIndices[row]]->name
+                  << ", 已报名 " << athleteTable.registrationCounts[row] << " 项)\n";
     }
 }
 
@@ -351,7 +599,8 @@ void SportsMeet::showEventDetails(const std::string& eventName, Gender gender) c
     }
     
     std::cout << "\n--- 项目详情: " << event->name << " (" << genderToString(event->gender) << ") ---\n";
-    std::cout << "类型: " << (event->isTimeBased ? "径赛(计时)" : "田赛(计分)") << "\n";
+    std::cout << "类型: " << (event->isTimeBased ? "径赛(计时)" : "田赛(计分)")
+              << "，" << disciplineToString(event->discipline) << "类\n";
     std::cout << "状态: " << (event->isCancelled ? "已取消" : "正常") << "\n";
     std::cout << "计分规则: " << event->scoringRule.ruleName << "\n";
     std::cout << "持续时间: " << event->durationMinutes << " 分钟\n";
@@ -360,22 +609,53 @@ void SportsMeet::showEventDetails(const std::string& eventName, Gender gender) c
     if (!event->registeredAthletes.empty()) {
         std::cout << "已报名运动员:\n";
         for (size_t i = 0; i < event->registeredAthletes.size(); ++i) {
-            Athlete* athlete = findAthlete(event->registeredAthletes[i]);
+            Athlete* athlete = getAthlete(event->registeredAthletes[i]);
             if (athlete) {
                 std::cout << i + 1 << ". " << athlete->name << " (" << athlete->id 
-                          << "), " << genderToString(athlete->gender) << ", " << athlete->unit->name << "\n";
+                          << "), " << genderToString(athlete->gender) << ", " << athlete->unit->name;
+                double mark = event->entryMark(athlete->handle);
+                if (mark > 0) {
+                    std::cout << ", 报名成绩 " << mark;
+                }
+                std::cout << "\n";
+            }
+        }
+    }
+
+    // 多轮项目显示各轮进度和当前轮次的成绩
+    if (!event->rounds.empty()) {
+        std::cout << "\n比赛轮次:\n";
+        for (std::size_t i = 0; i < event->rounds.size(); ++i) {
+            const Round& round = event->rounds[i];
+            const int index = static_cast<int>(i);
+            std::cout << "  " << round.name << ": "
+                      << (index < event->currentRound ? "已完成" : index == event->currentRound ? "进行中" : "未开始");
+            if (index > 0 && index <= event->currentRound) {
+                std::cout << "，" << round.entrants.size() << " 人参赛";
+            }
+            if (i + 1 < event->rounds.size()) {
+                std::cout << "，每组前 " << round.qualifiersPerHeat << " 名及成绩最好的 " << round.fastestLosers << " 名晋级";
+            }
+            std::cout << "\n";
+        }
+        if (!event->inFinalRound() && !event->roundResults().empty()) {
+            std::cout << "\n" << event->roundName(event->currentRound) << "成绩记录:\n";
+            const std::vector<Result>& roundResults = event->roundResults();
+            for (std::size_t i = 0; i < roundResults.size(); ++i) {
+                if (const Athlete* athlete = getAthlete(roundResults[i].athlete)) {
+                    std::cout << i + 1 << ". " << athlete->name << " (" << athlete->unit->name << "): "
+                              << roundResults[i].performance << (event->isTimeBased ? " 秒" : " 米") << "\n";
+                }
             }
         }
     }
     
     // 显示项目成绩
-    std::string eventKey = eventName + "_" + genderToString(gender);
-    auto resultsIt = eventResults.find(eventKey);
-    if (resultsIt != eventResults.end() && !resultsIt->second.empty()) {
+    if (!event->results.empty()) {
         std::cout << "\n成绩记录:\n";
-        for (size_t i = 0; i < resultsIt->second.size(); ++i) {
-            const auto& result = resultsIt->second[i];
-            Athlete* athlete = findAthlete(result.athleteId);
+        for (size_t i = 0; i < event->results.size(); ++i) {
+            const auto& result = event->results[i];
+            Athlete* athlete = getAthlete(result.athlete);
             if (athlete) {
                 std::cout << i + 1 << ". " << athlete->name << " (" << athlete->unit->name << "): " 
                           << result.performance << (event->isTimeBased ? " 秒" : " 米") << "\n";
@@ -392,39 +672,34 @@ void SportsMeet::showUnitResults(const std::string& unitName) const {
     }
 
     std::cout << "\n--- " << unitName << " 成绩汇总 ---\n";
-    std::cout << "单位总分: " << unit->score << "\n\n";
+    std::cout << "单位总分: " << unit->score << "\n";
+    std::cout << "名次统计: 第一名 " << unit->medalCounts[0] << " 个, 第二名 " << unit->medalCounts[1]
+              << " 个, 第三名 " << unit->medalCounts[2] << " 个\n\n";
 
-    bool foundResults = false;
-    for (const auto& pair : eventResults) {
-        const std::string& eventName = pair.first;
-        const std::vector<Result>& results = pair.second;
-        
-        std::vector<const Result*> unitEventResults;
-        for (const auto& result : results) {
-            const Athlete* athlete = findAthlete(result.athleteId);
-            if (athlete && athlete->unit->name == unitName && result.rank > 0) {
-                unitEventResults.push_back(&result);
-            }
-        }
+    if (unit->placings.empty()) {
+        std::cout << "该单位目前没有获得任何名次。\n";
+        return;
+    }
 
-        if (!unitEventResults.empty()) {
-            foundResults = true;
-            const Event* event = findEvent(eventName, findAthlete(unitEventResults[0]->athleteId)->gender);
-            std::cout << "--- 项目: " << eventName << " (" << genderToString(event->gender) << ") ---\n";
-             for (const auto* result : unitEventResults) {
-                const Athlete* athlete = findAthlete(result->athleteId);
-                std::cout << "  - " << std::left << std::setw(15) << athlete->name
-                          << "名次: " << std::setw(5) << result->rank
-                          << "成绩: " << std::setw(10) << result->performance
-                          << "得分: " << result->points << "\n";
+    // 直接读取单位的成绩汇总，不再扫描其他单位的成绩
+    EventHandle currentEvent = INVALID_HANDLE;
+    const Event* event = nullptr;
+    for (const auto& placing : unit->placings) {
+        if (placing.event != currentEvent) {
+            if (event) {
+                std::cout << "  项目得分: " << unit->pointsByEvent.at(currentEvent) << "\n\n";
             }
-            std::cout << "\n";
+            currentEvent = placing.event;
+            event = getEvent(currentEvent);
+            std::cout << "--- 项目: " << event->name << " (" << genderToString(event->gender) << ") ---\n";
         }
+        const Athlete* athlete = getAthlete(placing.athlete);
+        std::cout << "  - " << std::left << std::setw(15) << athlete->name
+                  << "名次: " << std::setw(5) << placing.rank
+                  << "成绩: " << std::setw(10) << placing.performance
+                  << "得分: " << placing.points << "\n";
     }
-
-    if (!foundResults) {
-        std::cout << "该单位目前没有获得任何名次。\n";
-    }
+    std::cout << "  项目得分: " << unit->pointsByEvent.at(currentEvent) << "\n\n";
 }
 
 void SportsMeet::showAthleteResults(const std::string& athleteId) const {
@@ -437,20 +712,18 @@ void SportsMeet::showAthleteResults(const std::string& athleteId) const {
     std::cout << "\n--- " << athlete->name << " (ID: " << athleteId << ") 成绩汇总 ---\n";
     std::cout << "个人总分: " << athlete->score << "\n\n";
 
+    // 通过运动员的成绩反向索引直接定位，代价只与本人成绩数量相关
     bool foundResults = false;
-    for (const auto& pair : eventResults) {
-        const std::string& eventName = pair.first;
-        const std::vector<Result>& results = pair.second;
-
-        for (const auto& result : results) {
-            if (result.athleteId == athleteId && result.rank > 0) {
-                foundResults = true;
-                const Event* event = findEvent(eventName, athlete->gender);
-                 std::cout << "--- 项目: " << eventName << " (" << genderToString(event->gender) << ") ---\n";
-                 std::cout << "  - 名次: " << result.rank
-                           << ", 成绩: " << result.performance
-                           << ", 得分: " << result.points << "\n\n";
-            }
+    for (const auto& ref : athlete->results) {
+        const Event* event = getEvent(ref.event);
+        if (!event) continue;
+        const Result& result = event->results[ref.index];
+        if (result.rank > 0) {
+            foundResults = true;
+            std::cout << "--- 项目: " << event->name << " (" << genderToString(event->gender) << ") ---\n";
+            std::cout << "  - 名次: " << result.rank
+                      << ", 成绩: " << result.performance
+                      << ", 得分: " << result.points << "\n\n";
         }
     }
     
@@ -464,6 +737,82 @@ void SportsMeet::cancelEvent(const std::string& eventName) {
     // It should find an event and set its `isCancelled` flag to true.
 }
 
+void SportsMeet::setEventRounds(const std::string& eventName, Gender gender, const std::vector<Round>& rounds) {
+    Event* event = findEvent(eventName, gender);
+    if (!event) {
+        std::cout << "错误: 未找到项目 '" << eventName << "' (" << genderToString(gender) << ")。\n";
+        return;
+    }
+    bool hasResults = !event->results.empty() || event->currentRound > 0;
+    for (const Round& round : event->rounds) {
+        hasResults = hasResults || !round.results.empty();
+    }
+    if (hasResults) {
+        std::cout << "错误: 项目 '" << eventName << "' 已有成绩，不能修改比赛轮次。\n";
+        return;
+    }
+    for (std::size_t i = 0; i + 1 < rounds.size(); ++i) {
+        if (rounds[i].qualifiersPerHeat < 0 || rounds[i].fastestLosers < 0 ||
+            rounds[i].qualifiersPerHeat + rounds[i].fastestLosers == 0) {
+            std::cout << "错误: " << rounds[i].name << "必须至少有一个晋级名额。\n";
+            return;
+        }
+    }
+
+    noteScheduleChange(event);
+    event->currentRound = 0;
+    event->rounds.clear();
+    if (rounds.size() <= 1) {
+        std::cout << "项目 '" << eventName << "' 已设置为直接决赛。\n";
+        return;
+    }
+    for (const Round& round : rounds) {
+        event->rounds.emplace_back(round.name, round.qualifiersPerHeat, round.fastestLosers);
+    }
+    // 决赛没有晋级名额
+    event->rounds.back().qualifiersPerHeat = 0;
+    event->rounds.back().fastestLosers = 0;
+    std::cout << "项目 '" << eventName << "' 的比赛轮次已设置为：";
+    for (std::size_t i = 0; i < event->rounds.size(); ++i) {
+        const Round& round = event->rounds[i];
+        std::cout << (i > 0 ? " -> " : "") << round.name;
+        if (i + 1 < event->rounds.size()) {
+            std::cout << "（每组前 " << round.qualifiersPerHeat << " 名 + 成绩最好的 " << round.fastestLosers << " 名）";
+        }
+    }
+    std::cout << "\n";
+}
+
+void SportsMeet::closeEventRound(const std::string& eventName, Gender gender) {
+    Event* event = findEvent(eventName, gender);
+    if (!event) {
+        std::cout << "错误: 未找到项目 '" << eventName << "' (" << genderToString(gender) << ")。\n";
+        return;
+    }
+    if (event->inFinalRound()) {
+        std::cout << "错误: 项目 '" << eventName << "' 当前为" << (event->rounds.empty() ? "直接决赛" : "决赛")
+                  << "，没有需要结束的轮次。\n";
+        return;
+    }
+    const std::vector<Result>& results = event->roundResults();
+    if (results.empty()) {
+        std::cout << "错误: 项目 '" << eventName << "' " << event->roundName(event->currentRound) << "尚未录入任何成绩。\n";
+        return;
+    }
+
+    // 没有成绩的参赛者记为弃权（DNS），不参与晋级
+    for (AthleteHandle entrant : event->roundEntrants()) {
+        bool hasResult = std::any_of(results.begin(), results.end(), [entrant](const Result& result) {
+            return result.athlete == entrant;
+        });
+        if (hasResult) continue;
+        if (const Athlete* athlete = getAthlete(entrant)) {
+            std::cout << athlete->name << " (" << athlete->unit->name << ") 未录入成绩，记为弃权 (DNS)。\n";
+        }
+    }
+    advanceRound(event);
+}
+
 void SportsMeet::manageScoringRules() {
     while (true) {
         std::cout << "\n--- 计分规则管理 ---\n";
@@ -577,13 +926,20 @@ void SportsMeet::recordAndScoreEvent(Event* event) {
         std::cout << "该项目没有运动员报名。\n";
         return;
     }
+    if (!event->rounds.empty()) {
+        std::cout << "当前轮次: " << event->roundName(event->currentRound) << "\n";
+    }
 
-    for (const auto& athleteId : event->registeredAthletes) {
-        const Athlete* athlete = findAthlete(athleteId);
-        if (!athlete) continue;
+    auto recordFor = [this, event](AthleteHandle handle, int lane) {
+        const Athlete* athlete = getAthlete(handle);
+        if (!athlete) return;
 
         double performance;
-        std::cout << "请输入运动员 " << athlete->name << " (ID: " << athleteId << ") 的成绩: ";
+        std::cout << "请输入";
+        if (lane > 0) {
+            std::cout << "第" << lane << "道";
+        }
+        std::cout << "运动员 " << athlete->name << " (ID: " << athlete->id << ") 的成绩: ";
         std::cin >> performance;
         while (std::cin.fail()) {
             std::cout << "输入无效，请输入一个数字: ";
@@ -591,7 +947,25 @@ void SportsMeet::recordAndScoreEvent(Event* event) {
             std::cin.ignore(256,'\n');
             std::cin >> performance;
         }
-        recordResult(event->name, event->gender, athleteId, performance);
+        recordResult(event->name, event->gender, athlete->id, performance);
+    };
+
+    // 分组进行的项目按组和道次录入，各组成绩合并计算名次；分组后新报名的运动员最后录入。
+    // 本轮最后一个成绩录入后项目会晋级到下一轮并重新分组，因此先复制本轮的分组和参赛者
+    const std::vector<Heat> heats = event->heats;
+    const std::vector<AthleteHandle> entrants = event->roundEntrants();
+    std::vector<AthleteHandle> recorded;
+    for (const Heat& heat : heats) {
+        std::cout << "第" << heat.number << "组:\n";
+        for (std::size_t i = 0; i < heat.entrants.size(); ++i) {
+            recordFor(heat.entrants[i], heat.lanes[i]);
+            recorded.push_back(heat.entrants[i]);
+        }
+    }
+    for (AthleteHandle handle : entrants) {
+        if (std::find(recorded.begin(), recorded.end(), handle) == recorded.end()) {
+            recordFor(handle, 0);
+        }
     }
 }
 
@@ -601,17 +975,18 @@ void SportsMeet::processScoresForEvent(const std::string& eventName, Gender gend
         std::cout << "错误: 未找到项目 '" << eventName << "' (" << genderToString(gender) << ")。\n";
         return;
     }
+    if (!event->inFinalRound()) {
+        std::cout << "项目 '" << eventName << "' 尚未进行到决赛（当前为" << event->roundName(event->currentRound) << "），不能计分。\n";
+        return;
+    }
     
-    // 使用 eventName + "_" + gender 作为键
-    std::string eventKey = eventName + "_" + genderToString(gender);
-    auto resultsIt = eventResults.find(eventKey);
-    if (resultsIt == eventResults.end() || resultsIt->second.empty()) {
+    if (event->results.empty()) {
         std::cout << "没有可用于计分的成绩记录。\n";
         return;
     }
     
     // 复制比赛结果以进行排序
-    std::vector<Result> results = resultsIt->second;
+    std::vector<Result> results = event->results;
     
     // 按照成绩排序 (计时赛和计分赛的排序方向相反)
     if (event->isTimeBased) {
@@ -649,6 +1024,18 @@ void SportsMeet::processScoresForEvent(const std::string& eventName, Gender gend
     std::cout << "使用规则：" << rule.ruleName << "\n";
     std::cout << "参赛人数：" << results.size() << "\n";
     
+    // 撤销该项目之前的计分，重复计分时不会重复累加
+    for (auto& result : results) {
+        if (result.rank > 0) {
+            if (Athlete* athlete = getAthlete(result.athlete)) {
+                awardPoints(athlete, -result.points);
+                athlete->unit->removePlacings(event->handle);
+            }
+        }
+        result.rank = 0;
+        result.points = 0;
+    }
+    
     // 计分人数不能超过参赛人数或计分表的长度
     int placesToAward = std::min(static_cast<size_t>(subRule->scores.size()), results.size());
     
@@ -656,22 +1043,12 @@ void SportsMeet::processScoresForEvent(const std::string& eventName, Gender gend
         results[i].rank = i + 1;
         results[i].points = subRule->scores[i];
         
-        Athlete* athlete = findAthlete(results[i].athleteId);
+        Athlete* athlete = getAthlete(results[i].athlete);
         if (athlete) {
-            athlete->score += results[i].points;
-            
-            // 找到运动员所属单位并计分
-            for (auto& unit : units) {
-                auto athlete_it = std::find_if(unit->athletes.begin(), unit->athletes.end(),
-                    [&](const std::unique_ptr<Athlete>& a) { 
-                        return a->id == results[i].athleteId; 
-                    });
-                
-                if (athlete_it != unit->athletes.end()) {
-                    unit->score += results[i].points;
-                    break;
-                }
-            }
+            // 运动员及所属单位同步计分，并更新单位成绩汇总
+            awardPoints(athlete, results[i].points);
+            athlete->unit->addPlacing({event->handle, athlete->handle, results[i].rank,
+                                       results[i].performance, results[i].points});
             
             std::cout << results[i].rank << ". " 
                       << athlete->name << ": " 
@@ -680,141 +1057,847 @@ void SportsMeet::processScoresForEvent(const std::string& eventName, Gender gend
         }
     }
     
-    // 更新事件结果
-    resultsIt->second = results;
+    // 更新事件结果，排序改变了下标，同步更新运动员的成绩反向索引
+    event->results = std::move(results);
+    indexEventResults(event);
+}
+
+void SportsMeet::recordRoundResult(Event* event, Athlete* athlete, double performance) {
+    const std::vector<AthleteHandle>& entrants = event->roundEntrants();
+    const std::string roundName = event->roundName(event->currentRound);
+    if (std::find(entrants.begin(), entrants.end(), athlete->handle) == entrants.end()) {
+        std::cout << "错误: 运动员 " << athlete->name << " 未参加项目 '" << event->name << "' 的" << roundName << "。\n";
+        return;
+    }
+
+    // 非决赛轮次的成绩只用于晋级，重复录入时覆盖原成绩
+    std::vector<Result>& results = event->roundResults();
+    auto it = std::find_if(results.begin(), results.end(), [athlete](const Result& result) {
+        return result.athlete == athlete->handle;
+    });
+    if (it != results.end()) {
+        it->performance = performance;
+    } else {
+        results.emplace_back(athlete->handle, performance);
+    }
+    std::cout << "已记录 " << athlete->name << " 在项目 '" << event->name << "' " << roundName << "的成绩: " << performance << "\n";
+
+    if (RoundQualifier::complete(entrants, results)) {
+        advanceRound(event);
+    }
+}
+
+/**
+ * @brief 晋级到下一轮
+ * @details 本轮成绩录入完整时调用：按晋级规则产生下一轮的参赛者，以本轮成绩为种子重新分组，
+ * 并立即把下一轮的场次安排在本轮结束之后，无需重新生成秩序册。
+ */
+void SportsMeet::advanceRound(Event* event) {
+    const Round& round = event->rounds[event->currentRound];
+    std::vector<RoundQualifier::Qualifier> qualifiers = RoundQualifier::qualify(
+        event->heats, event->roundEntrants(), round.results, event->isTimeBased,
+        round.qualifiersPerHeat, round.fastestLosers);
+
+    const std::string label = event->name + " (" + genderToString(event->gender) + ")";
+    if (qualifiers.empty()) {
+        std::cout << "警告：项目 " << label << " " << round.name << "没有产生晋级者。\n";
+        return;
+    }
+
+    Round& next = event->rounds[event->currentRound + 1];
+    std::cout << "\n--- 项目 " << label << " " << round.name << "结束，晋级" << next.name << " ---\n";
+    next.entrants.clear();
+    for (std::size_t i = 0; i < qualifiers.size(); ++i) {
+        const RoundQualifier::Qualifier& qualifier = qualifiers[i];
+        next.entrants.push_back(qualifier.athlete);
+        if (const Athlete* athlete = getAthlete(qualifier.athlete)) {
+            std::cout << i + 1 << ". " << athlete->name << " (" << athlete->unit->name << "): "
+                      << qualifier.performance << " " << (qualifier.byPlace ? "Q" : "q") << "\n";
+        }
+    }
+    event->currentRound++;
+
+    allocateHeats(event);
+    scheduleCurrentRound(event);
 }
 
 
 // --- 秩序册实现 ---
 
+// 场次在项目名后标注轮次和组号，只进行一轮且不分组时为空
+static std::string heatLabel(const Event* event, int round, int heat) {
+    std::string label;
+    if (!event->rounds.empty()) {
+        label += " " + event->roundName(round);
+    }
+    if (heat > 0) {
+        label += " 第" + std::to_string(heat) + "组";
+    }
+    return label;
+}
+
 /**
  * @brief 生成秩序册
  * @details 使用一个更复杂的算法来安排所有赛事。
  * 它会优先安排参与者多的项目，并尝试在每日的上下午时间窗口中均衡地安排赛事。
  */
 void SportsMeet::generateSchedule() {
-    // 首先清空现有秩序册
+    cancelUnderfilledEvents();
+    scheduleChanges.clear();
+
+    // 清空现有秩序册，已结束轮次的场次原样保留
+    const std::vector<ScheduledSession> completed = completedRoundSessions();
     schedule.clear();
-    
-    // 检查所有项目的报名人数，标记参赛人数不足的项目为已取消
-    for (auto& event : events) {
-        if (!event->isCancelled && event->registeredAthletes.size() < (size_t)minParticipantsForCancel) {
-            std::cout << "项目 '" << event->name << " (" << genderToString(event->gender) << ")' 参赛人数不足，该项目被取消。\n";
-            event->isCancelled = true;
-        }
+    for (const ScheduledSession& session : completed) {
+        schedule.addSession(session);
     }
     
-    std::vector<Event*> eventsToSchedule;
-    for (auto& event : events) {
-        // 只安排有选手报名的、未被取消的项目
-        if (!event->isCancelled && !event->registeredAthletes.empty()) {
-            eventsToSchedule.push_back(event.get());
-        }
-    }
-    
-    if (eventsToSchedule.empty()) {
+    if (eventsToSchedule().empty()) {
         std::cout << "没有需要安排的项目。" << std::endl;
         return;
     }
     
-    // 按项目的参赛人数降序排序，优先安排复杂项目
-    std::sort(eventsToSchedule.begin(), eventsToSchedule.end(), [](const Event* a, const Event* b) {
-        return a->registeredAthletes.size() > b->registeredAthletes.size();
-    });
-    
     std::cout << "\n正在生成秩序册...\n";
+    allocateHeats();
+    std::vector<ScheduleUnit> units = scheduleUnits();
     
-    const int timeStep = 15;     // 以15分钟为步长寻找可用时间
+    // 按场次的参赛人数降序排序，着色时同等约束下优先安排复杂场次
+    std::stable_sort(units.begin(), units.end(), [](const ScheduleUnit& a, const ScheduleUnit& b) {
+        return a.entrants->size() > b.entrants->size();
+    });
+
+    // 冲突图预处理：共享参赛者的场次互相冲突。DSATUR 着色给出从最受约束开始的
+    // 安排顺序，颜色类按时长均衡分配到各天作为建议比赛日
+    ConflictGraph conflicts;
+    conflicts.build(units);
+    std::vector<int> colors;
+    std::vector<std::uint32_t> scheduleOrder;
+    int colorCount = conflicts.colorDsatur(colors, scheduleOrder);
+    std::vector<int> dayHints = conflicts.assignDays(colors, colorCount, competitionDays);
+
+    // 冲突团中的场次只能依次进行且两两间隔休息时间
+    std::vector<std::uint32_t> clique = conflicts.greedyClique();
+    long cliqueMinutes = 0;
+    for (std::uint32_t node : clique) {
+        cliqueMinutes += conflicts.getUnit(node).durationMinutes;
+    }
+    const long dailyMinutes = (morningEndTime - morningStartTime) + (afternoonEndTime - afternoonStartTime);
+    int minDays = MinimumDaysSearch::chainDays(cliqueMinutes, static_cast<long>(clique.size()), dailyMinutes, 2,
+                                               Schedule::ATHLETE_REST_MINUTES);
+    std::cout << "冲突分析：" << conflicts.nodeCount() << " 个场次，" << conflicts.edgeCount() << " 对冲突，"
+              << "着色数 " << colorCount << "，最大冲突团 " << clique.size() << " 个场次，"
+              << "至少需要 " << minDays << " 天。\n";
+    if (minDays > competitionDays) {
+        std::cout << "警告：当前比赛天数 " << competitionDays << " 天不足以安排所有冲突场次！\n";
+    }
     
-    // 使用实例中的时间窗口设置
-    const std::vector<std::pair<int, int>> timeWindows = {
-        {morningStartTime, morningEndTime},      // 上午时间窗口
-        {afternoonStartTime, afternoonEndTime}  // 下午时间窗口
+    // 候选评估拆分为 天 × 场地 × 时间窗口 的独立任务，可选地在线程池中并行；按任务下标的顺序归约，
+    // 同分时取较早的一天、靠前的场地和窗口，结果与串行评估完全相同。任务太少时直接串行评估
+    const std::pair<int, int> timeWindows[] = {
+        {morningStartTime, morningEndTime},
+        {afternoonStartTime, afternoonEndTime}
     };
+    constexpr std::size_t windowCount = sizeof(timeWindows) / sizeof(timeWindows[0]);
+    std::vector<DayBitmap> blockedMasks;
+    std::vector<SlotCandidate> taskBest;
+    std::vector<DayLoad> dayLoads(competitionDays);
     
-    for (Event* event : eventsToSchedule) {
-        long bestScore = -1;
-        int bestDay = -1;
-        int bestStartTime = -1;
-        // 根据项目类型（计时/计分）分配场地
-        std::string venue = event->isTimeBased ? "主场" : "副场";
+    for (std::uint32_t node : scheduleOrder) {
+        const ScheduleUnit& unit = conflicts.getUnit(node);
+        Event* event = unit.event;
+        const int hintDay = dayHints[node];
+        std::vector<VenueHandle> candidateVenues = venuesFor(event);
+        if (candidateVenues.empty()) {
+            std::cout << "警告：没有适合项目 " << event->name << "（" << disciplineToString(event->discipline) << "）的场地！" << std::endl;
+            continue;
+        }
         
-        for (int day = 1; day <= competitionDays; ++day) {
-            for (const auto& window : timeWindows) {
-                for (int startTime = window.first; startTime <= window.second - event->durationMinutes; startTime += timeStep) {
-                    int endTime = startTime + event->durationMinutes;
-                    
-                    // 检查场地和所有运动员是否都可用
-                    bool isAvailable = schedule.isVenueAvailable(venue, day, startTime, endTime);
-                    if (isAvailable) {
-                        for (const auto& athleteId : event->registeredAthletes) {
-                            Athlete* athlete = findAthlete(athleteId);
-                            if (!athlete || !schedule.isAthleteAvailable(athlete, day, startTime, endTime)) {
-                                isAvailable = false;
-                                break;
-                            }
-                        }
+        SlotCandidate best;
+        if (unit.round > 0) {
+            // 之后的轮次只能在上一轮结束并休息之后进行，取最早的可行时间
+            const std::pair<int, int> ready = roundReadyTime(event);
+            best = earliestSlot(unit, candidateVenues, ready.first, ready.second);
+        } else {
+            const std::size_t venueCount = candidateVenues.size();
+            const std::size_t taskCount = static_cast<std::size_t>(competitionDays) * venueCount * windowCount;
+            if (schedulePool && taskCount >= PARALLEL_MIN_TASKS) {
+                for (int day = 1; day <= competitionDays; ++day) {
+                    dayLoads[day - 1] = schedule.getDayLoad(day);
+                }
+                // 合并所有参赛者位图的代价最大，先按 (天, 场地) 各合并一次，同一场地当天的各窗口共用
+                const std::size_t maskCount = static_cast<std::size_t>(competitionDays) * venueCount;
+                blockedMasks.resize(maskCount);
+                schedulePool->parallelFor(maskCount, [&](std::size_t mask) {
+                    const int day = static_cast<int>(mask / venueCount) + 1;
+                    blockedMasks[mask] = schedule.blockedMask(*unit.entrants, candidateVenues[mask % venueCount], day);
+                });
+                taskBest.assign(taskCount, SlotCandidate());
+                schedulePool->parallelFor(taskCount, [&](std::size_t task) {
+                    const std::size_t window = task % windowCount;
+                    const std::size_t mask = task / windowCount;
+                    const int day = static_cast<int>(mask / venueCount) + 1;
+                    taskBest[task] = evaluateWindow(unit, candidateVenues[mask % venueCount], day, timeWindows[window],
+                                                    hintDay, blockedMasks[mask], dayLoads[day - 1]);
+                });
+                for (const SlotCandidate& candidate : taskBest) {
+                    if (candidate.day != -1 && (best.day == -1 || candidate.score < best.score)) {
+                        best = candidate;
                     }
-                    
-                    // 如果找到可用时间，则计算一个分数来评估这个时间点的好坏（倾向于靠前和均衡）
-                    if (isAvailable) {
-                        int morningEvents = 0;
-                        int afternoonEvents = 0;
-                        for (const auto& session : schedule.getFullSchedule()) {
-                            if (session.day == day) {
-                                if (session.startTime < 13 * 60) morningEvents++;
-                                else afternoonEvents++;
-                            }
-                        }
-                        if (startTime < 13 * 60) morningEvents++;
-                        else afternoonEvents++;
-                        
-                        long balancePenalty = std::abs(morningEvents - afternoonEvents);
-                        long currentScore = (long)day * 100000 + balancePenalty * 1000 + startTime;
-                        
-                        if (bestScore == -1 || currentScore < bestScore) {
-                            bestScore = currentScore;
-                            bestDay = day;
-                            bestStartTime = startTime;
-                        }
+                }
+            } else {
+                for (int day = 1; day <= competitionDays; ++day) {
+                    SlotCandidate candidate = evaluateDay(unit, candidateVenues, day, hintDay);
+                    if (candidate.day != -1 && (best.day == -1 || candidate.score < best.score)) {
+                        best = candidate;
                     }
                 }
             }
         }
         
-        // 将项目安排在找到的最佳时间
-        if (bestDay != -1) {
-            schedule.addSession(bestDay, bestStartTime, bestStartTime + event->durationMinutes, venue, event);
+        // 将场次安排在找到的最佳场地和时间
+        if (best.day != -1) {
+            schedule.addSession(best.day, best.startTime, best.startTime + unit.durationMinutes,
+                                schedule.getVenueName(best.venue), event, unit.round, unit.heat, *unit.entrants, unit.lanes);
         } else {
-            std::cout << "警告：项目 " << event->name << " 无法在 " << competitionDays << " 天内找到合适的时间安排！" << std::endl;
+            std::cout << "警告：项目 " << event->name << heatLabel(event, unit.round, unit.heat) << " 无法在 " << competitionDays << " 天内找到合适的时间安排！" << std::endl;
         }
     }
     
     std::cout << "秩序册生成完毕！" << std::endl;
+    showVenueUtilization();
 }
 
-/**
- * @brief 显示秩序册
- * @details 从 Schedule 对象获取数据并格式化输出，包含每日详情和参赛者列表。
- */
-void SportsMeet::showSchedule() const {
-    const auto& full_schedule = schedule.getFullSchedule();
-    if (full_schedule.empty()) {
-        std::cout << "\n秩序册为空，请先生成秩序册。\n";
+std::vector<VenueHandle> SportsMeet::venuesFor(const Event* event) {
+    std::vector<VenueHandle> result;
+    for (const Venue& venue : venues) {
+        if (venue.supports(event->discipline)) {
+            result.push_back(schedule.getVenueHandle(venue.name));
+        }
+    }
+    return result;
+}
+
+void SportsMeet::showVenueUtilization() const {
+    const long capacity = static_cast<long>(competitionDays) *
+        ((morningEndTime - morningStartTime) + (afternoonEndTime - afternoonStartTime));
+    if (venues.empty() || capacity <= 0) {
         return;
     }
+    std::vector<long> minutes(venues.size(), 0);
+    std::vector<int> sessions(venues.size(), 0);
+    for (const auto& session : schedule.getFullSchedule()) {
+        for (std::size_t i = 0; i < venues.size(); ++i) {
+            if (venues[i].name == session.venue) {
+                minutes[i] += session.endTime - session.startTime;
+                sessions[i]++;
+                break;
+            }
+        }
+    }
+    std::cout << "场地使用率：\n";
+    for (std::size_t i = 0; i < venues.size(); ++i) {
+        // 以千分比计算后手动输出一位小数，避免改动 cout 的格式状态
+        long permille = minutes[i] * 1000 / capacity;
+        std::cout << "  " << venues[i].name << "：" << sessions[i] << " 场，" << minutes[i] << " 分钟，"
+                  << permille / 10 << "." << permille % 10 << "%\n";
+    }
+}
 
-    // 按天和时间排序
-    auto sorted_schedule = full_schedule;
-    std::sort(sorted_schedule.begin(), sorted_schedule.end(), [](const ScheduledSession& a, const ScheduledSession& b) {
-        if (a.day != b.day) return a.day < b.day;
-        return a.startTime < b.startTime;
-    });
+void SportsMeet::cancelUnderfilledEvents() {
+    for (auto& event : events) {
+        cancelIfUnderfilled(event.get());
+    }
+}
 
-    std::cout << "\n======================== 运动会秩序册 ========================\n" << std::endl;
+bool SportsMeet::cancelIfUnderfilled(Event* event) {
+    if (!event->isCancelled && event->registeredAthletes.size() < (size_t)minParticipantsForCancel) {
+        std::cout << "项目 '" << event->name << " (" << genderToString(event->gender) << ")' 参赛人数不足，该项目被取消。\n";
+        event->isCancelled = true;
+        return true;
+    }
+    return false;
+}
 
-    int current_day = -1;
-    for (const auto& session : sorted_schedule) {
+void SportsMeet::noteScheduleChange(const Event* event) {
+    if (std::find(scheduleChanges.begin(), scheduleChanges.end(), event->handle) == scheduleChanges.end()) {
+        scheduleChanges.push_back(event->handle);
+    }
+}
+
+std::vector<Event*> SportsMeet::eventsToSchedule() const {
+    std::vector<Event*> result;
+    for (const auto& event : events) {
+        // 只安排有选手报名的、未被取消的项目
+        if (!event->isCancelled && !event->registeredAthletes.empty()) {
+            result.push_back(event.get());
+        }
+    }
+    return result;
+}
+
+int SportsMeet::laneCountFor(const Event* event) const {
+    if (!event->isTimeBased || event->discipline != Discipline::TRACK) {
+        return 0;
+    }
+    // 分组须能在任一适合的场地上进行，取最少的跑道数
+    int lanes = 0;
+    for (const Venue& venue : venues) {
+        if (venue.supports(event->discipline) && venue.lanes > 0) {
+            lanes = lanes == 0 ? venue.lanes : std::min(lanes, venue.lanes);
+        }
+    }
+    return lanes;
+}
+
+void SportsMeet::allocateHeats() {
+    for (const auto& event : events) {
+        event->heats.clear();
+    }
+    for (Event* event : eventsToSchedule()) {
+        allocateHeats(event);
+    }
+}
+
+bool SportsMeet::allocateHeats(Event* event) {
+    event->heats.clear();
+    const std::vector<AthleteHandle>& entrants = event->roundEntrants();
+    const int lanes = laneCountFor(event);
+    if (lanes == 0 || entrants.size() <= static_cast<std::size_t>(lanes)) {
+        return false;
+    }
+    // 第一轮以报名成绩作为种子成绩，之后各轮以上一轮的成绩作为种子成绩
+    const std::vector<Result>& seedResults =
+        event->currentRound > 0 ? event->rounds[event->currentRound - 1].results : event->entryMarks;
+    std::vector<double> seeds(entrants.size(), 0.0);
+    for (std::size_t i = 0; i < entrants.size(); ++i) {
+        for (const Result& result : seedResults) {
+            if (result.athlete == entrants[i]) {
+                seeds[i] = result.performance;
+                break;
+            }
+        }
+    }
+    event->heats = HeatAllocator::allocate(entrants, seeds, lanes, event->durationMinutes);
+    std::cout << "分组：" << event->name << " (" << genderToString(event->gender) << ")"
+              << heatLabel(event, event->currentRound, 0) << " "
+              << entrants.size() << " 人分为 " << event->heats.size() << " 组，每组 "
+              << event->heats.front().durationMinutes << " 分钟。\n";
+    return true;
+}
+
+void SportsMeet::appendRoundUnits(Event* event, std::vector<ScheduleUnit>& units) const {
+    if (event->heats.empty()) {
+        units.push_back({event, 0, &event->roundEntrants(), event->durationMinutes, event->currentRound});
+        return;
+    }
+    for (const Heat& heat : event->heats) {
+        units.push_back({event, heat.number, &heat.entrants, heat.durationMinutes, event->currentRound, &heat.lanes});
+    }
+}
+
+std::vector<ScheduleUnit> SportsMeet::scheduleUnits() const {
+    std::vector<ScheduleUnit> units;
+    for (Event* event : eventsToSchedule()) {
+        appendRoundUnits(event, units);
+    }
+    return units;
+}
+
+std::vector<ScheduledSession> SportsMeet::completedRoundSessions() const {
+    std::vector<ScheduledSession> completed;
+    for (const auto& session : schedule.getFullSchedule()) {
+        if (!session.event->isCancelled && session.round < session.event->currentRound) {
+            completed.push_back(session);
+        }
+    }
+    return completed;
+}
+
+std::pair<int, int> SportsMeet::roundReadyTime(const Event* event) const {
+    int day = 1;
+    int lastEnd = -1;
+    for (const auto& session : schedule.getFullSchedule()) {
+        if (session.event == event && session.round < event->currentRound &&
+            (session.day > day || (session.day == day && session.endTime > lastEnd))) {
+            day = session.day;
+            lastEnd = session.endTime;
+        }
+    }
+    return {day, lastEnd < 0 ? 0 : lastEnd + Schedule::ATHLETE_REST_MINUTES};
+}
+
+SchedulePlan SportsMeet::makeSchedulePlan() {
+    SchedulePlan plan(competitionDays,
+                      {{morningStartTime, morningEndTime}, {afternoonStartTime, afternoonEndTime}},
+                      scheduleTimeStep);
+    // 只有各项目当前轮次的场次参与排程，已结束轮次的场次原样保留，占用场地和参赛者
+    for (const ScheduledSession& session : completedRoundSessions()) {
+        plan.addFixed({session.event, schedule.getVenueHandle(session.venue), session.day, session.startTime,
+                       session.endTime, session.round, session.heat, session.entrantHandles(), session.laneNumbers()});
+    }
+    std::map<std::tuple<const Event*, int, int>, const ScheduledSession*> sessionOf;
+    for (const auto& session : schedule.getFullSchedule()) {
+        sessionOf.emplace(std::make_tuple(session.event, session.round, session.heat), &session);
+    }
+    std::map<const Event*, std::pair<int, int>> readyTimes;
+    for (const ScheduleUnit& unit : scheduleUnits()) {
+        std::vector<VenueHandle> allowed = venuesFor(unit.event);
+        auto it = sessionOf.find(std::make_tuple(unit.event, unit.round, unit.heat));
+        if (it != sessionOf.end()) {
+            const ScheduledSession* session = it->second;
+            plan.addUnit(unit, std::move(allowed), schedule.getVenueHandle(session->venue), session->day, session->startTime);
+        } else {
+            VenueHandle venue = allowed.empty() ? INVALID_HANDLE : allowed.front();
+            plan.addUnit(unit, std::move(allowed), venue);
+        }
+        if (unit.round > 0) {
+            auto ready = readyTimes.find(unit.event);
+            if (ready == readyTimes.end()) {
+                ready = readyTimes.emplace(unit.event, roundReadyTime(unit.event)).first;
+            }
+            plan.setEarliestStart(static_cast<std::uint32_t>(plan.size() - 1), ready->second.first, ready->second.second);
+        }
+    }
+    plan.finalize();
+    return plan;
+}
+
+static void printObjective(const char* label, const SchedulePlan::Objective& objective) {
+    std::cout << label << "目标值 " << objective.total()
+              << "（未安排 " << objective.unscheduled << " 项，使用 " << objective.daysUsed << " 天，"
+              << "上下午不均衡 " << objective.imbalance << "，场地空闲 " << objective.idleVenueMinutes << " 分钟）\n";
+}
+
+void SportsMeet::optimizeSchedule(int budgetMillis) {
+    if (schedule.getFullSchedule().empty()) {
+        std::cout << "\n秩序册为空，请先生成秩序册。\n";
+        return;
+    }
+
+    SchedulePlan plan = makeSchedulePlan();
+    ScheduleOptimizer optimizer(plan);
+    ScheduleOptimizer::Stats stats = optimizer.run(std::chrono::milliseconds(budgetMillis));
+
+    std::cout << "\n--- 秩序册优化 ---\n";
+    printObjective("优化前：", stats.before);
+    printObjective("优化后：", stats.after);
+    std::cout << "共尝试 " << stats.iterations << " 次移动，接受 " << stats.accepted << " 次，用时 "
+              << stats.elapsedMillis << " 毫秒。\n";
+
+    if (stats.after.total() < stats.before.total()) {
+        plan.commit(schedule);
+        std::cout << "已采用优化后的秩序册。\n";
+        showVenueUtilization();
+    } else {
+        std::cout << "未找到更好的方案，秩序册保持不变。\n";
+    }
+}
+
+SportsMeet::SlotCandidate SportsMeet::evaluateDay(const ScheduleUnit& unit, const std::vector<VenueHandle>& venues, int day, int hintDay) const {
+    // 使用实例中的时间窗口设置
+    const std::pair<int, int> timeWindows[] = {
+        {morningStartTime, morningEndTime},      // 上午时间窗口
+        {afternoonStartTime, afternoonEndTime}  // 下午时间窗口
+    };
+
+    DayLoad load = schedule.getDayLoad(day);
+    SlotCandidate best;
+    // 同分时取列表中靠前的场地
+    for (VenueHandle venue : venues) {
+        // 场地与所有参赛者当天的占用合并为一张位图，一次找出全部可行的开始时间
+        DayBitmap blocked = schedule.blockedMask(*unit.entrants, venue, day);
+        for (const auto& window : timeWindows) {
+            SlotCandidate candidate = evaluateWindow(unit, venue, day, window, hintDay, blocked, load);
+            if (candidate.day != -1 && (best.day == -1 || candidate.score < best.score)) {
+                best = candidate;
+            }
+        }
+    }
+    return best;
+}
+
+SportsMeet::SlotCandidate SportsMeet::evaluateWindow(const ScheduleUnit& unit, VenueHandle venue, int day,
+                                                     const std::pair<int, int>& window, int hintDay,
+                                                     const DayBitmap& blocked, const DayLoad& load) const {
+    SlotCandidate best;
+    std::vector<int> feasibleStarts;
+    // 开始时间按步长对齐，空闲段内逐步长取点，占用段整段跳过
+    blocked.collectFreeStarts(window.first, window.second, unit.durationMinutes, scheduleTimeStep, feasibleStarts);
+    for (int startTime : feasibleStarts) {
+        // 计算一个分数来评估这个时间点的好坏（倾向于靠前和均衡）
+        int morningEvents = load.morningSessions;
+        int afternoonEvents = load.afternoonSessions;
+        if (startTime < Schedule::AFTERNOON_START) morningEvents++;
+        else afternoonEvents++;
+
+        long balancePenalty = std::abs(morningEvents - afternoonEvents);
+        // 从建议比赛日开始依次往后（循环）优先
+        long dayOffset = (day - hintDay + competitionDays) % competitionDays;
+        long currentScore = dayOffset * 100000 + balancePenalty * 1000 + startTime;
+
+        if (best.score == -1 || currentScore < best.score) {
+            best.score = currentScore;
+            best.day = day;
+            best.startTime = startTime;
+            best.venue = venue;
+        }
+    }
+    return best;
+}
+
+SportsMeet::SlotCandidate SportsMeet::earliestSlot(const ScheduleUnit& unit, const std::vector<VenueHandle>& venues, int fromDay, int fromMinute) const {
+    const std::pair<int, int> timeWindows[] = {
+        {morningStartTime, morningEndTime},
+        {afternoonStartTime, afternoonEndTime}
+    };
+
+    SlotCandidate best;
+    std::vector<int> feasibleStarts;
+    for (int day = std::max(fromDay, 1); day <= competitionDays && best.day == -1; ++day) {
+        const int notBefore = day == fromDay ? fromMinute : 0;
+        // 同一时间取列表中靠前的场地
+        for (VenueHandle venue : venues) {
+            DayBitmap blocked = schedule.blockedMask(*unit.entrants, venue, day);
+            for (const auto& window : timeWindows) {
+                feasibleStarts.clear();
+                blocked.collectFreeStarts(window.first, window.second, unit.durationMinutes, scheduleTimeStep, feasibleStarts);
+                auto it = std::lower_bound(feasibleStarts.begin(), feasibleStarts.end(), notBefore);
+                if (it != feasibleStarts.end() && (best.day == -1 || *it < best.startTime)) {
+                    best.score = *it;
+                    best.day = day;
+                    best.startTime = *it;
+                    best.venue = venue;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+void SportsMeet::scheduleCurrentRound(Event* event) {
+    if (schedule.getFullSchedule().empty()) {
+        std::cout << "秩序册为空，" << event->roundName(event->currentRound) << "将在生成秩序册时安排。\n";
+        return;
+    }
+
+    // 本轮不早于之前各轮最后一个场次结束后的休息时间
+    const std::pair<int, int> ready = roundReadyTime(event);
+
+    std::vector<ScheduleUnit> units;
+    appendRoundUnits(event, units);
+    const std::vector<VenueHandle> candidateVenues = venuesFor(event);
+    for (const ScheduleUnit& unit : units) {
+        const std::string label = event->name + " (" + genderToString(event->gender) + ")" + heatLabel(event, unit.round, unit.heat);
+        SlotCandidate best = earliestSlot(unit, candidateVenues, ready.first, ready.second);
+        if (best.day == -1) {
+            std::cout << "警告：项目 " << label << " 无法在 " << competitionDays << " 天内找到合适的时间安排！\n";
+            continue;
+        }
+        schedule.addSession(best.day, best.startTime, best.startTime + unit.durationMinutes,
+                            schedule.getVenueName(best.venue), event, unit.round, unit.heat, *unit.entrants, unit.lanes);
+        std::cout << "已安排 " << label << "：第 " << best.day << " 天 "
+                  << TimeUtils::toHHMM(best.startTime) << "，" << schedule.getVenueName(best.venue) << "\n";
+    }
+}
+
+bool SportsMeet::sessionValid(std::uint32_t index) {
+    const ScheduledSession& session = schedule.getSession(index);
+    if (session.day < 1 || session.day > competitionDays) {
+        return false;
+    }
+    const std::vector<VenueHandle> allowed = venuesFor(session.event);
+    if (std::find(allowed.begin(), allowed.end(), schedule.getVenueHandle(session.venue)) == allowed.end()) {
+        return false;
+    }
+    const bool inWindow = (session.startTime >= morningStartTime && session.endTime <= morningEndTime) ||
+                          (session.startTime >= afternoonStartTime && session.endTime <= afternoonEndTime);
+    return inWindow && !schedule.sessionConflicts(index);
+}
+
+void SportsMeet::repairSchedule() {
+    std::vector<Event*> changed;
+    for (EventHandle handle : scheduleChanges) {
+        if (Event* event = getEvent(handle)) {
+            changed.push_back(event);
+        }
+    }
+    repairSchedule(changed);
+}
+
+/**
+ * @brief 增量修复秩序册
+ * @details 报名变动后无需重新生成整个秩序册：只对有变动的项目重新检查人数、重新分组，
+ * 原来的场次能放回原处的保留原安排，否则重新安排，优先回到原来的比赛日；
+ * 与这些项目共享运动员的场次（冲突图中的邻居）重新检查，失效的一并重新安排。
+ * 其余场次不做任何改动，已结束轮次的场次原样保留。
+ */
+void SportsMeet::repairSchedule(const std::vector<Event*>& changedEvents) {
+    if (schedule.getFullSchedule().empty()) {
+        std::cout << "\n秩序册为空，请先生成秩序册。\n";
+        return;
+    }
+    std::vector<Event*> changed = changedEvents;
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    scheduleChanges.clear();
+    if (changed.empty()) {
+        std::cout << "\n上次排程之后没有报名、轮次或场地变动，无需修复。\n";
+        return;
+    }
+
+    // 1. 撤下变动项目当前轮次的场次，记下原安排；已取消或无人报名的项目所有场次直接移除
+    struct OldSlot {
+        const Event* event;
+        int heat;
+        VenueHandle venue;
+        int day;
+        int startTime;
+    };
+    std::vector<OldSlot> oldSlots;
+    std::vector<std::uint32_t> stale;
+    std::vector<Event*> toPlace;
+    std::vector<AthleteHandle> affectedAthletes;
+    std::size_t removed = 0;
+    for (Event* event : changed) {
+        cancelIfUnderfilled(event);
+        const bool scheduled = !event->isCancelled && !event->registeredAthletes.empty();
+        for (std::uint32_t index : schedule.sessionsOf(event)) {
+            const ScheduledSession& session = schedule.getSession(index);
+            if (!scheduled) {
+                stale.push_back(index);
+                removed++;
+            } else if (session.round == event->currentRound) {
+                stale.push_back(index);
+                oldSlots.push_back({event, session.heat, schedule.getVenueHandle(session.venue), session.day, session.startTime});
+            }
+        }
+        affectedAthletes.insert(affectedAthletes.end(), event->registeredAthletes.begin(), event->registeredAthletes.end());
+        if (scheduled) {
+            toPlace.push_back(event);
+        }
+    }
+    schedule.removeSessions(stale);
+
+    // 2. 冲突图邻居：变动项目报名者的其余场次重新检查，失效的撤下并按原参赛名单重新安排
+    struct Displaced {
+        ScheduleUnit unit;
+        int oldDay;
+        int oldStart;
+    };
+    std::vector<Displaced> displaced;
+    std::deque<std::pair<std::vector<AthleteHandle>, std::vector<int>>> neighbourRosters; // 撤下的邻居场次的名单和道次
+    std::vector<std::uint32_t> invalid;
+    std::sort(affectedAthletes.begin(), affectedAthletes.end());
+    affectedAthletes.erase(std::unique(affectedAthletes.begin(), affectedAthletes.end()), affectedAthletes.end());
+    const std::vector<std::uint32_t> neighbours = schedule.sessionsOfAthletes(affectedAthletes);
+    for (std::uint32_t index : neighbours) {
+        const ScheduledSession& session = schedule.getSession(index);
+        // 已结束轮次的场次不做调整
+        if (session.round < session.event->currentRound || sessionValid(index)) continue;
+        neighbourRosters.emplace_back(session.entrantHandles(), session.laneNumbers());
+        const auto& roster = neighbourRosters.back();
+        displaced.push_back({{session.event, session.heat, &roster.first, session.endTime - session.startTime, session.round,
+                              roster.second.empty() ? nullptr : &roster.second},
+                             session.day, session.startTime});
+        invalid.push_back(index);
+    }
+    schedule.removeSessions(invalid);
+
+    // 3. 变动项目重新分组，各场次能放回原处的保留原安排
+    std::cout << "\n--- 增量修复秩序册 ---\n";
+    for (Event* event : toPlace) {
+        allocateHeats(event);
+    }
+    std::size_t kept = 0;
+    const std::size_t displacedNeighbours = displaced.size();
+    for (Event* event : toPlace) {
+        std::vector<ScheduleUnit> units;
+        appendRoundUnits(event, units);
+        const std::vector<VenueHandle> allowed = venuesFor(event);
+        const std::pair<int, int> ready = event->currentRound > 0 ? roundReadyTime(event) : std::make_pair(1, 0);
+        for (const ScheduleUnit& unit : units) {
+            auto old = std::find_if(oldSlots.begin(), oldSlots.end(), [&unit](const OldSlot& slot) {
+                return slot.event == unit.event && slot.heat == unit.heat;
+            });
+            if (old == oldSlots.end()) {
+                displaced.push_back({unit, -1, -1});
+                continue;
+            }
+            const int end = old->startTime + unit.durationMinutes;
+            const bool inWindow = (old->startTime >= morningStartTime && end <= morningEndTime) ||
+                                  (old->startTime >= afternoonStartTime && end <= afternoonEndTime);
+            const bool afterReady = std::make_pair(old->day, old->startTime) >= ready;
+            if (old->day >= 1 && old->day <= competitionDays && inWindow && afterReady &&
+                std::find(allowed.begin(), allowed.end(), old->venue) != allowed.end() &&
+                schedule.blockedMask(*unit.entrants, old->venue, old->day).isFree(old->startTime, end)) {
+                schedule.addSession(old->day, old->startTime, end, schedule.getVenueName(old->venue), event,
+                                    unit.round, unit.heat, *unit.entrants, unit.lanes);
+                kept++;
+            } else {
+                displaced.push_back({unit, old->day, old->startTime});
+            }
+        }
+    }
+
+    // 4. 逐个重新安排，参赛人数多的场次优先，原比赛日优先
+    std::stable_sort(displaced.begin(), displaced.end(), [](const Displaced& a, const Displaced& b) {
+        return a.unit.entrants->size() > b.unit.entrants->size();
+    });
+    for (const Displaced& item : displaced) {
+        const ScheduleUnit& unit = item.unit;
+        Event* event = unit.event;
+        const std::vector<VenueHandle> candidateVenues = venuesFor(event);
+        const int hintDay = (item.oldDay >= 1 && item.oldDay <= competitionDays) ? item.oldDay : 1;
+
+        SlotCandidate best;
+        if (unit.round > 0) {
+            const std::pair<int, int> ready = roundReadyTime(event);
+            best = earliestSlot(unit, candidateVenues, ready.first, ready.second);
+        } else {
+            for (int day = 1; day <= competitionDays; ++day) {
+                SlotCandidate candidate = evaluateDay(unit, candidateVenues, day, hintDay);
+                if (candidate.day != -1 && (best.day == -1 || candidate.score < best.score)) {
+                    best = candidate;
+                }
+            }
+        }
+
+        std::string label = event->name + " (" + genderToString(event->gender) + ")" + heatLabel(event, unit.round, unit.heat);
+        if (best.day == -1) {
+            std::cout << "警告：项目 " << label << " 无法在 " << competitionDays << " 天内找到合适的时间安排！\n";
+            continue;
+        }
+        schedule.addSession(best.day, best.startTime, best.startTime + unit.durationMinutes,
+                            schedule.getVenueName(best.venue), event, unit.round, unit.heat, *unit.entrants, unit.lanes);
+        std::cout << (item.oldDay == -1 ? "新增 " : "调整 ") << label << "：";
+        if (item.oldDay != -1) {
+            std::cout << "第 " << item.oldDay << " 天 " << TimeUtils::toHHMM(item.oldStart) << " -> ";
+        }
+        std::cout << "第 " << best.day << " 天 " << TimeUtils::toHHMM(best.startTime) << "，" << schedule.getVenueName(best.venue) << "\n";
+    }
+
+    std::cout << "修复完成：检查 " << changed.size() << " 个变动项目和 " << neighbours.size() << " 个相关场次，"
+              << "原位保留 " << kept << " 个场次，重新安排 " << displaced.size() << " 个场次（其中相关场次 "
+              << displacedNeighbours << " 个），移除 " << removed << " 个不再需要安排的场次，其余场次未改动。\n";
+}
+
+/**
+ * @brief 完全搜索生成秩序册
+ * @details 在贪心算法无法安排全部项目时使用：回溯搜索全部可能的安排，
+ * 在时间上限内要么找到可行方案，要么证明在当前天数内不存在可行方案。
+ */
+ExactScheduler::Outcome SportsMeet::generateScheduleExact(int timeLimitMillis) {
+    cancelUnderfilledEvents();
+    if (eventsToSchedule().empty()) {
+        std::cout << "没有需要安排的项目。" << std::endl;
+        return ExactScheduler::Outcome::Found;
+    }
+
+    std::cout << "\n正在完全搜索秩序册（时间上限 " << timeLimitMillis << " 毫秒）...\n";
+    // 从头搜索时重新分组；未找到方案时恢复原分组，与保留的原秩序册保持一致
+    std::vector<std::vector<Heat>> previousHeats;
+    for (const auto& event : events) {
+        previousHeats.push_back(event->heats);
+    }
+    allocateHeats();
+    SchedulePlan plan = makeSchedulePlan();
+    ExactScheduler solver(plan);
+    ExactScheduler::Stats stats = solver.solve(std::chrono::milliseconds(timeLimitMillis));
+
+    switch (stats.outcome) {
+        case ExactScheduler::Outcome::Found:
+            plan.commit(schedule);
+            scheduleChanges.clear();
+            std::cout << "找到可行的秩序册，所有 " << plan.size() << " 个场次均已安排。\n";
+            showVenueUtilization();
+            break;
+        case ExactScheduler::Outcome::Infeasible:
+            // 完全搜索只枚举按步长对齐的开始时间，结论不覆盖步长之间的开始时间
+            std::cout << "已证明：开始时间按 " << scheduleTimeStep << " 分钟步长对齐时，在 " << competitionDays
+                      << " 天内不存在满足全部约束的秩序册，原秩序册保持不变。\n";
+            break;
+        case ExactScheduler::Outcome::Timeout:
+            std::cout << "达到时间上限仍未得出结论，原秩序册保持不变。\n";
+            break;
+    }
+    if (stats.outcome != ExactScheduler::Outcome::Found) {
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            events[i]->heats = std::move(previousHeats[i]);
+        }
+    }
+    std::cout << "搜索节点 " << stats.nodes << " 个，用时 " << stats.elapsedMillis << " 毫秒。\n";
+    return stats.outcome;
+}
+
+/**
+ * @brief 计算最少比赛天数
+ * @details 先给出场地总时长、最忙运动员和冲突团三个下界，再以贪心排程二分查找能够安排全部场次的
+ * 最少天数，并在时间上限内用完全搜索尝试更少的天数。找到后将比赛天数设为该值并采用对应的秩序册。
+ */
+int SportsMeet::findMinimumDays(int timeLimitMillis) {
+    cancelUnderfilledEvents();
+    if (eventsToSchedule().empty()) {
+        std::cout << "没有需要安排的项目。" << std::endl;
+        return -1;
+    }
+
+    std::cout << "\n正在计算最少比赛天数...\n";
+    std::vector<std::vector<Heat>> previousHeats;
+    for (const auto& event : events) {
+        previousHeats.push_back(event->heats);
+    }
+    allocateHeats();
+    SchedulePlan plan = makeSchedulePlan();
+    MinimumDaysSearch search(plan, Schedule::ATHLETE_REST_MINUTES);
+    // 固定场次之后每个场次单独占用一天总能安排（只要时长不超过时间窗口），以此作为搜索上限
+    const int maxDays = std::max(plan.lastConstrainedDay() + static_cast<int>(plan.size()), competitionDays);
+    MinimumDaysSearch::Stats stats = search.run(maxDays, std::chrono::milliseconds(timeLimitMillis));
+
+    std::cout << "下界：场地 " << stats.bounds.venueDays << " 天，最忙运动员 " << stats.bounds.athleteDays
+              << " 天，冲突团 " << stats.bounds.cliqueDays << " 天";
+    if (!plan.getFixed().empty()) {
+        std::cout << "，已结束轮次 " << stats.bounds.fixedDays << " 天";
+    }
+    std::cout << "，至少需要 " << stats.bounds.lower() << " 天。\n";
+    if (stats.days == -1) {
+        std::cout << "在 " << maxDays << " 天内也无法安排全部场次，请检查场地设置和项目时长。原秩序册保持不变。\n";
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            events[i]->heats = std::move(previousHeats[i]);
+        }
+    } else {
+        competitionDays = stats.days;
+        plan.commit(schedule);
+        scheduleChanges.clear();
+        std::cout << "最少需要 " << stats.days << " 天";
+        if (!stats.provenOptimal) {
+            std::cout << "（未证明最优）";
+        } else if (stats.days == stats.bounds.lower()) {
+            std::cout << "（等于下界，已证明最优）";
+        } else {
+            std::cout << "（开始时间按 " << scheduleTimeStep << " 分钟步长对齐时已证明最优）";
+        }
+        std::cout << "，比赛天数已设为 " << stats.days << " 天并生成对应的秩序册。\n";
+        showVenueUtilization();
+    }
+    std::cout << "贪心探测 " << stats.probes << " 次，共用时 " << stats.elapsedMillis << " 毫秒。\n";
+    return stats.days;
+}
+
+/**
+ * @brief 显示秩序册
+ * @details 从 Schedule 对象获取数据并格式化输出，包含每日详情和参赛者列表。
+ */
+void SportsMeet::showSchedule() const {
+    if (schedule.getFullSchedule().empty()) {
+        std::cout << "\n秩序册为空，请先生成秩序册。\n";
+        return;
+    }
+
+    std::cout << "\n======================== 运动会秩序册 ========================\n" << std::endl;
+
+    // 秩序册按天和开始时间维护场次顺序，参赛者已预先解析，一次顺序遍历即可输出
+    int current_day = -1;
+    schedule.forEachInOrder([&current_day](const ScheduledSession& session) {
         if (session.day != current_day) {
             current_day = session.day;
             if (current_day > 1) {
@@ -826,35 +1909,112 @@ void SportsMeet::showSchedule() const {
                       << std::setw(20) << "场地" << std::endl;
             std::cout << "-------------------------------------------------------------------\n";
         }
-        
-        std::stringstream time_ss;
-        time_ss << std::setw(2) << std::setfill('0') << session.startTime / 60 << ":" << std::setw(2) << std::setfill('0') << session.startTime % 60
-                << " - "
-                << std::setw(2) << std::setfill('0') << session.endTime / 60 << ":" << std::setw(2) << std::setfill('0') << session.endTime % 60;
 
-        std::cout << std::left << std::setw(20) << time_ss.str()
-                  << std::setw(30) << session.event->name + " (" + genderToString(session.event->gender) + ")"
+        const std::string time = TimeUtils::toHHMM(session.startTime) + " - " + TimeUtils::toHHMM(session.endTime);
+
+        // 带组次的名称可能超出列宽，此时补一个空格与场地列隔开
+        std::string label = session.event->name + " (" + genderToString(session.event->gender) + ")" + heatLabel(session.event, session.round, session.heat);
+        if (label.size() >= 30) label += ' ';
+        std::cout << std::left << std::setw(20) << time
+                  << std::setw(30) << label
                   << std::setw(20) << session.venue << std::endl;
 
-        // 新增：显示该项目的所有参赛者
-        const auto& participants = session.event->registeredAthletes;
-        if (!participants.empty()) {
+        // 显示该场次的所有参赛者，分组场次同时显示道次
+        if (!session.roster.empty()) {
             std::string time_col_indent(20, ' ');
-            std::string list_indent(24, ' '); 
+            std::string list_indent(24, ' ');
 
             std::cout << time_col_indent << "  └ 参赛者:" << std::endl;
-            
-            for (const auto& athleteId : participants) {
-                const Athlete* athlete = findAthlete(athleteId);
-                if (athlete) {
-                     std::cout << list_indent << "- " << athlete->name 
-                               << " (" << athlete->unit->name << ")" << std::endl;
+            for (const SessionEntrant& entrant : session.roster) {
+                std::cout << list_indent << "- ";
+                if (entrant.lane > 0) {
+                    std::cout << "第" << entrant.lane << "道 ";
                 }
+                std::cout << entrant.athlete->name << " (" << entrant.unit->name << ")" << std::endl;
             }
         }
-    }
+    });
     std::cout << "\n==================================================================\n" << std::endl;
 }
+// 场次中某运动员的道次，不分道时为 0
+static int laneOf(const ScheduledSession& session, const Athlete* athlete) {
+    for (const SessionEntrant& entrant : session.roster) {
+        if (entrant.athlete == athlete) {
+            return entrant.lane;
+        }
+    }
+    return 0;
+}
+
+void SportsMeet::showAthleteSchedule(const std::string& athleteId) const {
+    const Athlete* athlete = findAthlete(athleteId);
+    if (!athlete) {
+        std::cout << "未找到学号为 " << athleteId << " 的运动员。\n";
+        return;
+    }
+
+    std::cout << "\n--- 个人赛程: " << athlete->name << " (" << athlete->unit->name << ") ---\n";
+    if (schedule.getSessionCount(athlete->handle) == 0) {
+        std::cout << "秩序册中没有该运动员的场次。\n";
+        return;
+    }
+    schedule.forEachSessionOf(athlete->handle, [athlete](const ScheduledSession& session) {
+        std::cout << "第 " << session.day << " 天 " << TimeUtils::toHHMM(session.startTime) << " - "
+                  << TimeUtils::toHHMM(session.endTime) << "  " << session.event->name << " ("
+                  << genderToString(session.event->gender) << ")" << heatLabel(session.event, session.round, session.heat);
+        int lane = laneOf(session, athlete);
+        if (lane > 0) {
+            std::cout << " 第" << lane << "道";
+        }
+        std::cout << "  " << session.venue << "\n";
+    });
+}
+
+// 按 RFC 4180 输出 CSV 字段：含逗号、引号或换行时整体加引号，内部的引号写两次
+static std::string csvField(const std::string& value) {
+    if (value.find_first_of(",\"\r\n") == std::string::npos) {
+        return value;
+    }
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+int SportsMeet::exportUnitTimetable(const std::string& unitName, const std::string& filename) const {
+    const Unit* unit = findUnit(unitName);
+    if (!unit) {
+        std::cout << "未找到单位: " << unitName << "\n";
+        return -1;
+    }
+    std::ofstream ofs(filename);
+    if (!ofs) {
+        std::cerr << "错误: 无法打开文件进行写入: " << filename << std::endl;
+        return -1;
+    }
+
+    // 每名运动员的场次已按时间排好，逐人输出即可
+    int rows = 0;
+    ofs << "学号,姓名,天,开始,结束,项目,组别,轮次,组号,道次,场地\n";
+    for (const auto& athlete : unit->athletes) {
+        const Athlete* current = athlete.get();
+        schedule.forEachSessionOf(current->handle, [&](const ScheduledSession& session) {
+            ofs << csvField(current->id) << "," << csvField(current->name) << "," << session.day << ","
+                << TimeUtils::toHHMM(session.startTime) << "," << TimeUtils::toHHMM(session.endTime) << ","
+                << csvField(session.event->name) << "," << genderToString(session.event->gender) << ","
+                << csvField(session.event->roundName(session.round)) << "," << session.heat << ","
+                << laneOf(session, current) << "," << csvField(session.venue) << "\n";
+            rows++;
+        });
+    }
+    std::cout << "已将单位 " << unit->name << " 的 " << unit->athletes.size() << " 名运动员共 " << rows
+              << " 个场次导出到 " << filename << "。\n";
+    return rows;
+}
+
 // ... 其他管理功能待实现 ...
 // void generateSchedule();
 // void recordResults();
@@ -878,15 +2038,6 @@ void write_vector(std::ofstream& ofs, const std::vector<T>& vec, Func write_elem
         write_element(ofs, elem);
     }
 }
-template<typename K, typename V, typename FuncV>
-void write_map(std::ofstream& ofs, const std::map<K, V>& m, FuncV write_value) {
-    size_t size = m.size();
-    write_binary(ofs, size);
-    for (const auto& pair : m) {
-        write_binary(ofs, pair.first);
-        write_value(ofs, pair.second);
-    }
-}
 
 // --- 各种数据结构的写入函数 ---
 void write_scoring_rule(std::ofstream& ofs, const ScoringRule& rule) {
@@ -915,6 +2066,19 @@ void write_unit_data(std::ofstream& ofs, const UnitData& data) {
     write_binary(ofs, data.score);
     write_vector(ofs, data.athletes, write_athlete_data);
 }
+void write_result(std::ofstream& ofs, const ResultData& result) {
+    write_binary(ofs, result.athleteId);
+    write_binary(ofs, result.performance);
+    write_binary(ofs, result.rank);
+    write_binary(ofs, result.points);
+}
+void write_round_data(std::ofstream& ofs, const RoundData& data) {
+    write_binary(ofs, data.name);
+    write_binary(ofs, data.qualifiersPerHeat);
+    write_binary(ofs, data.fastestLosers);
+    write_vector(ofs, data.entrants, [](std::ofstream& out, const std::string& str){ write_binary(out, str); });
+    write_vector(ofs, data.results, write_result);
+}
 void write_event_data(std::ofstream& ofs, const EventData& data) {
     write_binary(ofs, data.name);
     write_binary(ofs, data.gender);
@@ -923,12 +2087,16 @@ void write_event_data(std::ofstream& ofs, const EventData& data) {
     write_binary(ofs, data.scoringRuleName);
     write_binary(ofs, data.durationMinutes);
     write_vector(ofs, data.registeredAthletes, [](std::ofstream& out, const std::string& str){ write_binary(out, str); });
+    write_vector(ofs, data.results, write_result);
+    write_binary(ofs, data.discipline);
+    write_vector(ofs, data.rounds, write_round_data);
+    write_binary(ofs, data.currentRound);
+    write_vector(ofs, data.entryMarks, write_result);
 }
-void write_result(std::ofstream& ofs, const Result& result) {
-    write_binary(ofs, result.athleteId);
-    write_binary(ofs, result.performance);
-    write_binary(ofs, result.rank);
-    write_binary(ofs, result.points);
+void write_venue_data(std::ofstream& ofs, const VenueData& data) {
+    write_binary(ofs, data.name);
+    write_binary(ofs, data.capabilities);
+    write_binary(ofs, data.lanes);
 }
 
 
@@ -999,7 +2167,20 @@ void read_unit_data(std::ifstream& ifs, UnitData& data) {
     read_binary(ifs, data.score);
     read_vector(ifs, data.athletes, read_athlete_data);
 }
-void read_event_data(std::ifstream& ifs, EventData& data) {
+void read_result(std::ifstream& ifs, ResultData& result) {
+    read_binary(ifs, result.athleteId);
+    read_binary(ifs, result.performance);
+    read_binary(ifs, result.rank);
+    read_binary(ifs, result.points);
+}
+void read_round_data(std::ifstream& ifs, RoundData& data) {
+    read_binary(ifs, data.name);
+    read_binary(ifs, data.qualifiersPerHeat);
+    read_binary(ifs, data.fastestLosers);
+    read_vector(ifs, data.entrants, [](std::ifstream& in, std::string& str){ read_binary(in, str); });
+    read_vector(ifs, data.results, read_result);
+}
+void read_event_data(std::ifstream& ifs, EventData& data, int version) {
     read_binary(ifs, data.name);
     read_binary(ifs, data.gender);
     read_binary(ifs, data.isTimeBased);
@@ -1007,12 +2188,26 @@ void read_event_data(std::ifstream& ifs, EventData& data) {
     read_binary(ifs, data.scoringRuleName);
     read_binary(ifs, data.durationMinutes);
     read_vector(ifs, data.registeredAthletes, [](std::ifstream& in, std::string& str){ read_binary(in, str); });
+    if (version >= 2) {
+        read_vector(ifs, data.results, read_result);
+    }
+    if (version >= 4) {
+        read_binary(ifs, data.discipline);
+    } else {
+        data.discipline = inferDiscipline(data.name, data.isTimeBased);
+    }
+    if (version >= 5) {
+        read_vector(ifs, data.rounds, read_round_data);
+        read_binary(ifs, data.currentRound);
+    }
+    if (version >= 6) {
+        read_vector(ifs, data.entryMarks, read_result);
+    }
 }
-void read_result(std::ifstream& ifs, Result& result) {
-    read_binary(ifs, result.athleteId);
-    read_binary(ifs, result.performance);
-    read_binary(ifs, result.rank);
-    read_binary(ifs, result.points);
+void read_venue_data(std::ifstream& ifs, VenueData& data) {
+    read_binary(ifs, data.name);
+    read_binary(ifs, data.capabilities);
+    read_binary(ifs, data.lanes);
 }
 
 
@@ -1028,6 +2223,10 @@ void SportsMeet::backupData(const std::string& filename) const {
     dataPackage.morningEndTime = this->morningEndTime;
     dataPackage.afternoonStartTime = this->afternoonStartTime;
     dataPackage.afternoonEndTime = this->afternoonEndTime;
+    dataPackage.scheduleTimeStep = this->scheduleTimeStep;
+    for (const Venue& venue : this->venues) {
+        dataPackage.allVenues.push_back({venue.name, venue.capabilities, venue.lanes});
+    }
     dataPackage.allScoringRules = this->scoringRules;
 
     // 2. 填充单位和运动员数据
@@ -1041,7 +2240,11 @@ void SportsMeet::backupData(const std::string& filename) const {
             athleteData.name = athlete_ptr->name;
             athleteData.gender = athlete_ptr->gender;
             athleteData.score = athlete_ptr->score;
-            athleteData.registeredEvents = athlete_ptr->registeredEvents;
+            for (EventHandle eventHandle : athlete_ptr->registeredEvents) {
+                if (const Event* event = getEvent(eventHandle)) {
+                    athleteData.registeredEvents.push_back(event->name);
+                }
+            }
             unitData.athletes.push_back(athleteData);
         }
         dataPackage.allUnits.push_back(unitData);
@@ -1053,23 +2256,57 @@ void SportsMeet::backupData(const std::string& filename) const {
         eventData.name = event_ptr->name;
         eventData.gender = event_ptr->gender;
         eventData.isTimeBased = event_ptr->isTimeBased;
+        eventData.discipline = event_ptr->discipline;
         eventData.isCancelled = event_ptr->isCancelled;
         eventData.scoringRuleName = event_ptr->scoringRule.ruleName;
         eventData.durationMinutes = event_ptr->durationMinutes;
-        eventData.registeredAthletes = event_ptr->registeredAthletes;
+        for (AthleteHandle athleteHandle : event_ptr->registeredAthletes) {
+            if (const Athlete* athlete = getAthlete(athleteHandle)) {
+                eventData.registeredAthletes.push_back(athlete->id);
+            }
+        }
+        for (const auto& mark : event_ptr->entryMarks) {
+            if (const Athlete* athlete = getAthlete(mark.athlete)) {
+                eventData.entryMarks.push_back({athlete->id, mark.performance});
+            }
+        }
+        // 成绩随项目保存（句柄转换回学号）
+        for (const auto& result : event_ptr->results) {
+            if (const Athlete* athlete = getAthlete(result.athlete)) {
+                eventData.results.push_back({athlete->id, result.performance, result.rank, result.points});
+            }
+        }
+        // 多轮项目的轮次设置、晋级名单与各轮成绩
+        for (const Round& round : event_ptr->rounds) {
+            RoundData roundData;
+            roundData.name = round.name;
+            roundData.qualifiersPerHeat = round.qualifiersPerHeat;
+            roundData.fastestLosers = round.fastestLosers;
+            for (AthleteHandle athleteHandle : round.entrants) {
+                if (const Athlete* athlete = getAthlete(athleteHandle)) {
+                    roundData.entrants.push_back(athlete->id);
+                }
+            }
+            for (const auto& result : round.results) {
+                if (const Athlete* athlete = getAthlete(result.athlete)) {
+                    roundData.results.push_back({athlete->id, result.performance, result.rank, result.points});
+                }
+            }
+            eventData.rounds.push_back(roundData);
+        }
+        eventData.currentRound = event_ptr->currentRound;
         dataPackage.allEvents.push_back(eventData);
     }
 
-    // 4. 填充成绩数据
-    dataPackage.allEventResults = this->eventResults;
-
-    // 5. 写入文件
+    // 4. 写入文件
     std::ofstream ofs(filename, std::ios::binary);
     if (!ofs) {
         std::cerr << "错误: 无法打开文件进行写入: " << filename << std::endl;
         return;
     }
 
+    write_binary(ofs, BACKUP_MAGIC);
+    write_binary(ofs, BACKUP_VERSION);
     write_binary(ofs, dataPackage.maxEventsPerAthlete);
     write_binary(ofs, dataPackage.minParticipantsForCancel);
     write_binary(ofs, dataPackage.competitionDays);  // 写入比赛天数
@@ -1077,12 +2314,11 @@ void SportsMeet::backupData(const std::string& filename) const {
     write_binary(ofs, dataPackage.morningEndTime);
     write_binary(ofs, dataPackage.afternoonStartTime);
     write_binary(ofs, dataPackage.afternoonEndTime);
+    write_binary(ofs, dataPackage.scheduleTimeStep);
+    write_vector(ofs, dataPackage.allVenues, write_venue_data);
     write_vector(ofs, dataPackage.allScoringRules, write_scoring_rule);
     write_vector(ofs, dataPackage.allUnits, write_unit_data);
     write_vector(ofs, dataPackage.allEvents, write_event_data);
-    write_map(ofs, dataPackage.allEventResults, [](std::ofstream& out, const std::vector<Result>& results){
-        write_vector(out, results, write_result);
-    });
     
     ofs.close();
     std::cout << "数据备份成功。" << std::endl;
@@ -1101,19 +2337,49 @@ void SportsMeet::restoreData(const std::string& filename) {
     BackupData dataPackage;
 
     // 1. 从文件读取数据
-    read_binary(ifs, dataPackage.maxEventsPerAthlete);
+    // 版本 1 的文件没有文件头，第一个字段直接是 maxEventsPerAthlete
+    int version = 1;
+    int header;
+    read_binary(ifs, header);
+    if (header == BACKUP_MAGIC) {
+        read_binary(ifs, version);
+        read_binary(ifs, dataPackage.maxEventsPerAthlete);
+    } else {
+        dataPackage.maxEventsPerAthlete = header;
+    }
+    if (version > BACKUP_VERSION) {
+        std::cerr << "错误: 不支持的备份文件版本 " << version << std::endl;
+        return;
+    }
     read_binary(ifs, dataPackage.minParticipantsForCancel);
     read_binary(ifs, dataPackage.competitionDays);  // 读取比赛天数
     read_binary(ifs, dataPackage.morningStartTime);
     read_binary(ifs, dataPackage.morningEndTime);
     read_binary(ifs, dataPackage.afternoonStartTime);
     read_binary(ifs, dataPackage.afternoonEndTime);
+    if (version >= 3) {
+        read_binary(ifs, dataPackage.scheduleTimeStep);
+    }
+    if (version >= 4) {
+        read_vector(ifs, dataPackage.allVenues, read_venue_data);
+    }
     read_vector(ifs, dataPackage.allScoringRules, read_scoring_rule);
     read_vector(ifs, dataPackage.allUnits, read_unit_data);
-    read_vector(ifs, dataPackage.allEvents, read_event_data);
-    read_map(ifs, dataPackage.allEventResults, [](std::ifstream& in, std::vector<Result>& results){
-        read_vector(in, results, read_result);
+    read_vector(ifs, dataPackage.allEvents, [version](std::ifstream& in, EventData& data){
+        read_event_data(in, data, version);
     });
+    if (version == 1) {
+        read_map(ifs, dataPackage.legacyEventResults, [](std::ifstream& in, std::vector<ResultData>& results){
+            read_vector(in, results, read_result);
+        });
+        // 将旧格式按 "项目名_组别" 存放的成绩迁移到对应项目
+        for (auto& eventData : dataPackage.allEvents) {
+            auto it = dataPackage.legacyEventResults.find(eventData.name + "_" + genderToString(eventData.gender));
+            if (it != dataPackage.legacyEventResults.end()) {
+                eventData.results = std::move(it->second);
+            }
+        }
+    }
     
     ifs.close();
 
@@ -1121,8 +2387,18 @@ void SportsMeet::restoreData(const std::string& filename) {
     this->units.clear();
     this->events.clear();
     this->scoringRules.clear();
-    this->eventResults.clear();
+    // 对象已全部归还，整体回收对象池，保留已分配的块供重建时复用
+    this->athletePool.reset();
+    this->unitPool.reset();
+    this->eventPool.reset();
     this->schedule.clear();
+    this->scheduleChanges.clear();
+    this->athleteIndex.clear();
+    this->athleteHandles.clear();
+    this->eventHandles.clear();
+    this->eventIndex.clear();
+    this->athleteTable.clear();
+    this->registrations.clear();
 
     // 3. 恢复设置
     this->maxEventsPerAthlete = dataPackage.maxEventsPerAthlete;
@@ -1132,19 +2408,30 @@ void SportsMeet::restoreData(const std::string& filename) {
     this->morningEndTime = dataPackage.morningEndTime;
     this->afternoonStartTime = dataPackage.afternoonStartTime;
     this->afternoonEndTime = dataPackage.afternoonEndTime;
+    // 步长不合法时空闲段扫描无法前进，按设置时的范围检查，不合法时使用默认值
+    if (dataPackage.scheduleTimeStep >= MIN_TIME_STEP && dataPackage.scheduleTimeStep <= MAX_TIME_STEP) {
+        this->scheduleTimeStep = dataPackage.scheduleTimeStep;
+    } else {
+        std::cout << "警告：备份中的排程时间步长 " << dataPackage.scheduleTimeStep << " 分钟无效，已使用默认值 "
+                  << DEFAULT_TIME_STEP << " 分钟。\n";
+        this->scheduleTimeStep = DEFAULT_TIME_STEP;
+    }
+    if (!dataPackage.allVenues.empty()) {
+        this->venues.clear();
+        for (const auto& venueData : dataPackage.allVenues) {
+            this->venues.emplace_back(venueData.name, venueData.capabilities, venueData.lanes);
+        }
+    }
     this->scoringRules = dataPackage.allScoringRules;
 
     // 4. 重建单位和运动员
     for (const auto& unitData : dataPackage.allUnits) {
-        auto newUnit = std::make_unique<Unit>(unitData.name);
+        auto newUnit = unitPool.make(unitData.name, &athletePool);
         newUnit->score = unitData.score;
         for (const auto& athleteData : unitData.athletes) {
-            newUnit->addAthlete(athleteData.id, athleteData.name, athleteData.gender);
-            Athlete* pAthlete = newUnit->findAthlete(athleteData.id);
-            if(pAthlete) {
-                pAthlete->score = athleteData.score;
-                pAthlete->registeredEvents = athleteData.registeredEvents;
-            }
+            Athlete* pAthlete = newUnit->addAthlete(athleteData.id, athleteData.name, athleteData.gender);
+            pAthlete->score = athleteData.score;
+            indexAthlete(pAthlete, static_cast<std::uint32_t>(this->units.size()));
         }
         this->units.push_back(std::move(newUnit));
     }
@@ -1156,18 +2443,61 @@ void SportsMeet::restoreData(const std::string& filename) {
                                [&](const ScoringRule& rule){ return rule.ruleName == event_data.scoringRuleName; });
         
         if (it != scoringRules.end()) {
-            auto event = std::make_unique<Event>(event_data.name, event_data.gender, event_data.isTimeBased, *it, event_data.durationMinutes);
+            auto event = eventPool.make(event_data.name, event_data.gender, event_data.isTimeBased, event_data.discipline,
+                                        *it, event_data.durationMinutes);
             event->isCancelled = event_data.isCancelled;
-            event->registeredAthletes = event_data.registeredAthletes;
+            indexEvent(event.get());
+            // 报名关系以项目的报名名单为准（运动员侧只记录了项目名，无法区分组别）
+            for (const auto& athleteId : event_data.registeredAthletes) {
+                if (Athlete* athlete = findAthlete(athleteId)) {
+                    if (!registrations.test(athlete->handle, event->handle)) {
+                        linkRegistration(athlete, event.get());
+                    }
+                }
+            }
+            for (const auto& markData : event_data.entryMarks) {
+                if (Athlete* athlete = findAthlete(markData.athleteId)) {
+                    event->setEntryMark(athlete->handle, markData.performance);
+                }
+            }
+            // 恢复成绩（学号解析为句柄）
+            event->results.reserve(event_data.results.size());
+            for (const auto& resultData : event_data.results) {
+                if (Athlete* athlete = findAthlete(resultData.athleteId)) {
+                    Result result(athlete->handle, resultData.performance);
+                    result.rank = resultData.rank;
+                    result.points = resultData.points;
+                    event->results.push_back(result);
+                    // 单位总分已单独恢复，这里只重建成绩汇总
+                    if (result.rank > 0) {
+                        athlete->unit->addPlacing({event->handle, athlete->handle, result.rank,
+                                                   result.performance, result.points});
+                    }
+                }
+            }
+            indexEventResults(event.get());
+            // 恢复轮次（学号解析为句柄）
+            for (const auto& roundData : event_data.rounds) {
+                Round round(roundData.name, roundData.qualifiersPerHeat, roundData.fastestLosers);
+                for (const auto& athleteId : roundData.entrants) {
+                    if (Athlete* athlete = findAthlete(athleteId)) {
+                        round.entrants.push_back(athlete->handle);
+                    }
+                }
+                for (const auto& resultData : roundData.results) {
+                    if (Athlete* athlete = findAthlete(resultData.athleteId)) {
+                        round.results.emplace_back(athlete->handle, resultData.performance);
+                    }
+                }
+                event->rounds.push_back(std::move(round));
+            }
+            event->currentRound = event->rounds.empty() ? 0
+                : std::min(std::max(event_data.currentRound, 0), static_cast<int>(event->rounds.size()) - 1);
             this->events.push_back(std::move(event));
         }
     }
     
-    // 6. 恢复成绩
-    this->eventResults = dataPackage.allEventResults;
-    
-    // 7. 重置查询数据结构状态
-    this->isHashMapInitialized = false;
+    // 6. 重置演示用排序数组（学号索引已在第4步重建）
     this->isSortedVectorInitialized = false;
 
     std::cout << "数据恢复成功。" << std::endl;
@@ -1177,39 +2507,24 @@ const std::vector<ScoringRule>& SportsMeet::getScoringRules() const {
     return scoringRules;
 }
 
-// 初始化运动员查询数据结构
+// 初始化运动员查询数据结构（学号哈希索引始终保持最新，这里只构建排序数组）
 void SportsMeet::initializeAthleteSearchStructures() const {
-    // 清空之前的数据
-    athleteHashMap.clear();
     sortedAthletes.clear();
-    
-    // 收集所有运动员
-    for (const auto& unit : units) {
-        for (const auto& athlete : unit->athletes) {
-            athleteHashMap[athlete->id] = athlete.get();
-            sortedAthletes.emplace_back(athlete->id, athlete.get());
-        }
+    sortedAthletes.reserve(athleteIndex.size());
+    for (const auto& entry : athleteIndex) {
+        sortedAthletes.emplace_back(entry.first, entry.second);
     }
     
     // 排序以便进行二分查找
     std::sort(sortedAthletes.begin(), sortedAthletes.end(), 
               [](const auto& a, const auto& b) { return a.first < b.first; });
     
-    isHashMapInitialized = true;
     isSortedVectorInitialized = true;
 }
 
 // 使用哈希表查找运动员
 Athlete* SportsMeet::findAthleteByHash(const std::string& athleteId) const {
-    if (!isHashMapInitialized) {
-        initializeAthleteSearchStructures();
-    }
-    
-    auto it = athleteHashMap.find(athleteId);
-    if (it != athleteHashMap.end()) {
-        return it->second;
-    }
-    return nullptr;
+    return findAthlete(athleteId);
 }
 
 // 使用二分查找运动员
@@ -1240,12 +2555,7 @@ void SportsMeet::compareAthleteSearchAlgorithms() const {
     initializeAthleteSearchStructures();
     
     // 获取所有运动员ID用于测试
-    std::vector<std::string> athleteIds;
-    for (const auto& unit : units) {
-        for (const auto& athlete : unit->athletes) {
-            athleteIds.push_back(athlete->id);
-        }
-    }
+    const std::vector<std::string>& athleteIds = athleteTable.ids;
     
     if (athleteIds.empty()) {
         std::cout << "没有运动员信息，无法进行查询性能比较。\n";
@@ -1259,7 +2569,7 @@ void SportsMeet::compareAthleteSearchAlgorithms() const {
     {
         auto start = std::chrono::high_resolution_clock::now();
         for (const auto& id : athleteIds) {
-            Athlete* athlete = findAthlete(id);
+            Athlete* athlete = findAthleteLinear(id);
             if (!athlete) {
                 std::cout << "错误: 线性查找未找到运动员 " << id << "\n";
             }
@@ -1311,6 +2621,6 @@ void SportsMeet::compareAthleteSearchAlgorithms() const {
     std::cout << "实际表现见上述测试数据。\n";
     
     // 提示数据结构维护的开销
-    std::cout << "\n注意: 哈希表和排序数组需要在数据变更时更新，这会带来额外开销。\n";
+    std::cout << "\n注意: 哈希表随数据变更就地更新，排序数组则需要在数据变更后重建。\n";
     std::cout << "在大型比赛中，查询次数远多于变更次数时，优化的查找方法优势更为明显。\n";
 }
\ No newline at end of file
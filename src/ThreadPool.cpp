@@ -0,0 +1,86 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    for (unsigned i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+    if (workers.empty()) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &task;
+        jobCount = count;
+        nextIndex = 0;
+        pending = count;
+        ++generation;
+    }
+    wake.notify_all();
+
+    runTasks(task, count);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return pending == 0 && activeWorkers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::workerLoop() {
+    unsigned seen = 0;
+    while (true) {
+        const std::function<void(std::size_t)>* task;
+        std::size_t count;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            if (!job) {
+                continue; // 醒来时本次任务已经结束
+            }
+            task = job;
+            count = jobCount;
+            ++activeWorkers;
+        }
+
+        runTasks(*task, count);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --activeWorkers;
+        }
+        finished.notify_all();
+    }
+}
+
+void ThreadPool::runTasks(const std::function<void(std::size_t)>& task, std::size_t count) {
+    for (std::size_t i = nextIndex++; i < count; i = nextIndex++) {
+        task(i);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0) {
+            finished.notify_all();
+        }
+    }
+}
@@ -0,0 +1,123 @@
+#include "Timeline.h"
+#include <algorithm>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 最低置位的下标，调用方保证 word 非零
+static int lowestSetBit(std::uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+std::uint64_t DayBitmap::rangeMask(int word, int start, int end) {
+    int lo = std::max(start, word * 64) - word * 64;
+    int hi = std::min(end, word * 64 + 64) - word * 64;
+    if (hi - lo >= 64) {
+        return ~std::uint64_t(0);
+    }
+    return ((std::uint64_t(1) << (hi - lo)) - 1) << lo;
+}
+
+bool DayBitmap::isFree(int start, int end) const {
+    start = std::max(start, 0);
+    end = std::min(end, MINUTES_PER_DAY);
+    if (start >= end) {
+        return true;
+    }
+    for (int word = start / 64; word <= (end - 1) / 64; ++word) {
+        if (bits[word] & rangeMask(word, start, end)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DayBitmap::occupy(int start, int end) {
+    start = std::max(start, 0);
+    end = std::min(end, MINUTES_PER_DAY);
+    if (start >= end) {
+        return;
+    }
+    for (int word = start / 64; word <= (end - 1) / 64; ++word) {
+        bits[word] |= rangeMask(word, start, end);
+    }
+}
+
+int DayBitmap::findOccupied(int start, int end) const {
+    start = std::max(start, 0);
+    end = std::min(end, MINUTES_PER_DAY);
+    for (int word = start / 64; start < end && word <= (end - 1) / 64; ++word) {
+        std::uint64_t hits = bits[word] & rangeMask(word, start, end);
+        if (hits) {
+            return word * 64 + lowestSetBit(hits);
+        }
+    }
+    return end;
+}
+
+int DayBitmap::findFree(int start, int end) const {
+    start = std::max(start, 0);
+    end = std::min(end, MINUTES_PER_DAY);
+    for (int word = start / 64; start < end && word <= (end - 1) / 64; ++word) {
+        std::uint64_t hits = ~bits[word] & rangeMask(word, start, end);
+        if (hits) {
+            return word * 64 + lowestSetBit(hits);
+        }
+    }
+    return end;
+}
+
+void DayBitmap::collectFreeStarts(int windowStart, int windowEnd, int duration, int step,
+                                  std::vector<int>& starts) const {
+    windowEnd = std::min(windowEnd, MINUTES_PER_DAY);
+    int start = windowStart;
+    while (start <= windowEnd - duration) {
+        // 从当前位置起的空闲段一直延伸到下一个被占用的分钟，段内对齐步长的开始时间全部可行
+        int gapEnd = findOccupied(start, windowEnd);
+        for (; start + duration <= gapEnd; start += step) {
+            starts.push_back(start);
+        }
+        if (gapEnd >= windowEnd) {
+            break;
+        }
+        // 跳过整段占用，到下一个空闲分钟后第一个对齐步长的位置
+        int nextFree = findFree(gapEnd, windowEnd);
+        if (nextFree > start) {
+            start += (nextFree - start + step - 1) / step * step;
+        }
+    }
+}
+
+bool ResourceTimeline::isFree(int day, int start, int end) const {
+    const DayBitmap* bitmap = getDay(day);
+    return !bitmap || bitmap->isFree(start, end);
+}
+
+void ResourceTimeline::occupy(int day, int start, int end) {
+    if (day < 1) {
+        return;
+    }
+    if (static_cast<std::size_t>(day) > days.size()) {
+        days.resize(day);
+    }
+    days[day - 1].occupy(start, end);
+}
+
+void ResourceTimeline::clearDay(int day) {
+    if (day >= 1 && static_cast<std::size_t>(day) <= days.size()) {
+        days[day - 1].clear();
+    }
+}
+
+const DayBitmap* ResourceTimeline::getDay(int day) const {
+    if (day < 1 || static_cast<std::size_t>(day) > days.size()) {
+        return nullptr;
+    }
+    return &days[day - 1];
+}
@@ -1,17 +1,49 @@
 #include "Unit.h"
 #include "Athlete.h"
 #include <iostream>
+#include <algorithm>
 
-Unit::Unit(const std::string& name) : name(name), score(0) {}
+Unit::Unit(const std::string& name, ObjectPool<Athlete>* athletePool)
+    : name(name), score(0), athletePool(athletePool) {}
 
-void Unit::addAthlete(const std::string& athleteId, const std::string& athleteName, Gender gender) {
-    athletes.emplace_back(std::make_unique<Athlete>(athleteName, athleteId, gender, this));
+Athlete* Unit::addAthlete(const std::string& athleteId, const std::string& athleteName, Gender gender) {
+    if (athletePool) {
+        athletes.push_back(athletePool->make(athleteName, athleteId, gender, this));
+    } else {
+        athletes.emplace_back(new Athlete(athleteName, athleteId, gender, this));
+    }
+    return athletes.back().get();
 }
 
 void Unit::addScore(int points) {
     this->score += points;
 }
 
+void Unit::addPlacing(const UnitPlacing& placing) {
+    auto it = std::upper_bound(placings.begin(), placings.end(), placing, [](const UnitPlacing& a, const UnitPlacing& b) {
+        return a.event != b.event ? a.event < b.event : a.rank < b.rank;
+    });
+    placings.insert(it, placing);
+    pointsByEvent[placing.event] += placing.points;
+    if (placing.rank >= 1 && placing.rank <= 3) {
+        medalCounts[placing.rank - 1]++;
+    }
+}
+
+void Unit::removePlacings(EventHandle event) {
+    auto first = std::lower_bound(placings.begin(), placings.end(), event,
+        [](const UnitPlacing& p, EventHandle e) { return p.event < e; });
+    auto last = std::upper_bound(first, placings.end(), event,
+        [](EventHandle e, const UnitPlacing& p) { return e < p.event; });
+    for (auto it = first; it != last; ++it) {
+        if (it->rank >= 1 && it->rank <= 3) {
+            medalCounts[it->rank - 1]--;
+        }
+    }
+    placings.erase(first, last);
+    pointsByEvent.erase(event);
+}
+
 Athlete* Unit::findAthlete(const std::string& athleteId) {
     for (const auto& athlete : athletes) {
         if (athlete->id == athleteId) {
@@ -32,6 +32,7 @@ void handleScheduleManagement(SportsMeet& sm);
 void handleBackupAndRestore(SportsMeet& sm);
 void handleScoringRuleManagement(SportsMeet& sm);
 void handleSystemSettings(SportsMeet& sm);
+void handleVenueSettings(SportsMeet& sm);
 void loadSampleData(SportsMeet& sm);
 
 Event* selectEvent(SportsMeet& sm);
@@ -177,7 +178,8 @@ void handleEventManagement(SportsMeet& sm) {
         std::cout << "  1. 添加新项目\n";
         std::cout << "  2. 删除项目\n";
         std::cout << "  3. 查看所有项目\n";
-        std::cout << "  4. 返回上级菜单\n";
+        std::cout << "  4. 设置比赛轮次\n";
+        std::cout << "  5. 返回上级菜单\n";
         std::cout << "--------------------\n";
         std::cout << "请输入选项: ";
 
@@ -201,6 +203,16 @@ void handleEventManagement(SportsMeet& sm) {
                 std::cin >> isTimeBasedChoice;
                 std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
+                // 计时赛使用跑道，计分赛需选择田赛类别以分配场地
+                Discipline discipline = Discipline::TRACK;
+                if (isTimeBasedChoice != 1) {
+                    int disciplineChoice;
+                    std::cout << "请选择田赛类别 (1 表示跳跃, 2 表示投掷): ";
+                    std::cin >> disciplineChoice;
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    discipline = disciplineChoice == 2 ? Discipline::THROWS : Discipline::JUMPS;
+                }
+
                 // 选择计分规则
                 const auto& rules = sm.getScoringRules();
                 if (rules.empty()) {
@@ -234,7 +246,7 @@ void handleEventManagement(SportsMeet& sm) {
                     break;
                 }
 
-                sm.addEvent(name, gender, isTimeBasedChoice == 1, rules[ruleChoice - 1], durationMinutes);
+                sm.addEvent(name, gender, isTimeBasedChoice == 1, discipline, rules[ruleChoice - 1], durationMinutes);
                 break;
             }
             case 2: {
@@ -247,7 +259,45 @@ void handleEventManagement(SportsMeet& sm) {
             case 3:
                 sm.showAllEvents();
                 break;
-            case 4:
+            case 4: {
+                Event* event = selectEvent(sm);
+                if (!event) break;
+
+                std::cout << "请输入比赛轮次数（1 表示直接决赛，最多 4 轮）: ";
+                int roundCount;
+                if (!(std::cin >> roundCount) || roundCount < 1 || roundCount > 4) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "无效输入，请输入 1 到 4 之间的整数。\n";
+                    break;
+                }
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+                // 默认轮次名称，从决赛往前数
+                const char* defaultNames[] = {"决赛", "半决赛", "复赛", "预赛"};
+                std::vector<Round> rounds;
+                bool valid = true;
+                for (int i = 0; i < roundCount && valid; ++i) {
+                    Round round;
+                    round.name = defaultNames[roundCount - 1 - i];
+                    if (i + 1 < roundCount) {
+                        std::cout << round.name << "：请输入每组直接晋级人数和按成绩择优晋级人数（用空格分隔）: ";
+                        if (!(std::cin >> round.qualifiersPerHeat >> round.fastestLosers)) {
+                            std::cin.clear();
+                            valid = false;
+                        }
+                        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    }
+                    rounds.push_back(round);
+                }
+                if (!valid) {
+                    std::cout << "无效输入，请输入数字。\n";
+                    break;
+                }
+                sm.setEventRounds(event->name, event->gender, rounds);
+                break;
+            }
+            case 5:
                 return;
             default:
                 std::cout << "无效选项，请重试。\n";
@@ -269,6 +319,10 @@ void handleRegistrationManagement(SportsMeet& sm) {
 
         switch (choice) {
             case 1: {
+                Event* event = selectEvent(sm);
+                if (!event) break;
+                sm.showEligibleAthletes(event->name, event->gender);
+
                 std::string athleteId;
                 std::cout << "请输入要报名的运动员学号: ";
                 std::getline(std::cin, athleteId);
@@ -278,11 +332,20 @@ void handleRegistrationManagement(SportsMeet& sm) {
                     std::cout << "未找到该运动员。\n";
                     break;
                 }
+
+                // 计时项目的报名成绩用于分组时排种子
+                double entryMark = 0;
+                if (event->isTimeBased) {
+                    std::cout << "请输入报名成绩 (秒，用于分组排种子，没有请输入 0): ";
+                    while (!(std::cin >> entryMark)) {
+                        std::cout << "输入无效，请输入一个数字: ";
+                        std::cin.clear();
+                        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    }
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                }
                 
-                Event* event = selectEvent(sm);
-                if (!event) break;
-                
-                sm.registerAthleteForEvent(athleteId, event->name, event->gender);
+                sm.registerAthleteForEvent(athleteId, event->name, event->gender, entryMark);
                 break;
             }
             case 2:
@@ -300,7 +363,8 @@ void handleResultsManagement(SportsMeet& sm) {
         std::cout << "  2. 按项目查询成绩\n";
         std::cout << "  3. 按学院查询成绩\n";
         std::cout << "  4. 按运动员查询成绩\n";
-        std::cout << "  5. 返回上级菜单\n";
+        std::cout << "  5. 结束当前轮次（未录入成绩者记为弃权）\n";
+        std::cout << "  6. 返回上级菜单\n";
         std::cout << "--------------------\n";
         std::cout << "请输入选项: ";
         
@@ -345,7 +409,14 @@ void handleResultsManagement(SportsMeet& sm) {
                 sm.showAthleteResults(athleteId);
                 break;
             }
-            case 5:
+            case 5: {
+                Event* event = selectEvent(sm);
+                if (event) {
+                    sm.closeEventRound(event->name, event->gender);
+                }
+                break;
+            }
+            case 6:
                 return;
             default:
                 std::cout << "无效选项，请重试。\n";
@@ -362,7 +433,8 @@ void handleInfoQuery(SportsMeet& sm) {
         std::cout << "  4. 查询特定项目详情\n";
         std::cout << "  5. 查询运动员（学号）\n";
         std::cout << "  6. 运动员查询算法性能比较\n";
-        std::cout << "  7. 返回上级菜单\n";
+        std::cout << "  7. 查询运动员个人赛程\n";
+        std::cout << "  8. 返回上级菜单\n";
         std::cout << "--------------------\n";
         std::cout << "请输入选项: ";
         
@@ -401,7 +473,14 @@ void handleInfoQuery(SportsMeet& sm) {
             case 6:
                 sm.compareAthleteSearchAlgorithms();
                 break;
-            case 7:
+            case 7: {
+                std::string athleteId;
+                std::cout << "请输入运动员学号: ";
+                std::getline(std::cin, athleteId);
+                sm.showAthleteSchedule(athleteId);
+                break;
+            }
+            case 8:
                 return;
             default:
                 std::cout << "无效选项，请重试。\n";
@@ -414,7 +493,11 @@ void handleScheduleManagement(SportsMeet& sm) {
         std::cout << "\n--- 秩序册管理 ---\n";
         std::cout << "  1. 生成秩序册\n";
         std::cout << "  2. 查看秩序册\n";
-        std::cout << "  3. 返回主菜单\n";
+        std::cout << "  3. 优化秩序册\n";
+        std::cout << "  4. 完全搜索生成秩序册\n";
+        std::cout << "  5. 增量修复秩序册\n";
+        std::cout << "  6. 导出单位赛程表\n";
+        std::cout << "  7. 返回主菜单\n";
         std::cout << "--------------------\n";
         std::cout << "请输入选项: ";
 
@@ -435,7 +518,48 @@ void handleScheduleManagement(SportsMeet& sm) {
             case 2:
                 sm.showSchedule();
                 break;
-            case 3:
+            case 3: {
+                std::cout << "请输入优化时间上限（毫秒）: ";
+                int budget;
+                if (!(std::cin >> budget) || budget <= 0) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "无效输入，请输入大于0的整数。\n";
+                    break;
+                }
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                sm.optimizeSchedule(budget);
+                break;
+            }
+            case 4: {
+                std::cout << "请输入搜索时间上限（毫秒）: ";
+                int limit;
+                if (!(std::cin >> limit) || limit <= 0) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "无效输入，请输入大于0的整数。\n";
+                    break;
+                }
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                sm.generateScheduleExact(limit);
+                break;
+            }
+            case 5:
+                sm.repairSchedule();
+                break;
+            case 6: {
+                Unit* unit = selectUnit(sm);
+                if (!unit) break;
+                std::string filename;
+                std::cout << "请输入导出文件名 (例如 " << unit->name << "_赛程.csv): ";
+                std::getline(std::cin, filename);
+                if (filename.empty()) {
+                    filename = unit->name + "_赛程.csv";
+                }
+                sm.exportUnitTimetable(unit->name, filename);
+                break;
+            }
+            case 7:
                 return;
             default:
                 std::cout << "无效选项，请重试。\n";
@@ -483,6 +607,72 @@ void handleScoringRuleManagement(SportsMeet& sm) {
     sm.manageScoringRules();
 }
 
+void handleVenueSettings(SportsMeet& sm) {
+    while (true) {
+        std::cout << "\n--- 场地管理 ---\n";
+        std::cout << "  1. 查看场地\n";
+        std::cout << "  2. 添加场地\n";
+        std::cout << "  3. 删除场地\n";
+        std::cout << "  4. 返回上级菜单\n";
+        std::cout << "-----------------\n";
+        std::cout << "请输入选项: ";
+
+        int choice;
+        if(!(std::cin >> choice)) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            std::cout << "无效输入，请输入数字。\n";
+            continue;
+        }
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+        switch (choice) {
+            case 1:
+                sm.showVenues();
+                break;
+            case 2: {
+                std::string name;
+                std::cout << "请输入场地名称: ";
+                std::getline(std::cin, name);
+                int track, jumps, throws, lanes = 0;
+                std::cout << "是否有跑道、跳跃区、投掷区? (依次输入 1 或 0，用空格分隔): ";
+                if(!(std::cin >> track >> jumps >> throws)) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "无效输入，请输入数字。\n";
+                    break;
+                }
+                if (track == 1) {
+                    std::cout << "请输入跑道数: ";
+                    if(!(std::cin >> lanes)) {
+                        std::cin.clear();
+                        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                        std::cout << "无效输入，请输入数字。\n";
+                        break;
+                    }
+                }
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                unsigned capabilities = (track == 1 ? VENUE_TRACK : 0u) |
+                                        (jumps == 1 ? VENUE_JUMPS : 0u) |
+                                        (throws == 1 ? VENUE_THROWS : 0u);
+                sm.addVenue(name, capabilities, lanes);
+                break;
+            }
+            case 3: {
+                std::string name;
+                std::cout << "请输入要删除的场地名称: ";
+                std::getline(std::cin, name);
+                sm.removeVenue(name);
+                break;
+            }
+            case 4:
+                return;
+            default:
+                std::cout << "无效选项，请重试。\n";
+        }
+    }
+}
+
 void handleSystemSettings(SportsMeet& sm) {
     while (true) {
         std::cout << "\n--- 系统设置 ---\n";
@@ -490,8 +680,12 @@ void handleSystemSettings(SportsMeet& sm) {
         std::cout << "  2. 修改上午比赛时间段\n";
         std::cout << "  3. 修改下午比赛时间段\n";
         std::cout << "  4. 修改比赛天数\n";
-        std::cout << "  5. 查看当前系统设置\n";
-        std::cout << "  6. 返回上级菜单\n";
+        std::cout << "  5. 计算最少比赛天数\n";
+        std::cout << "  6. 修改排程时间步长\n";
+        std::cout << "  7. 修改排程线程数\n";
+        std::cout << "  8. 场地管理\n";
+        std::cout << "  9. 查看当前系统设置\n";
+        std::cout << "  10. 返回上级菜单\n";
         std::cout << "-----------------\n";
         std::cout << "请输入选项: ";
         
@@ -593,9 +787,55 @@ void handleSystemSettings(SportsMeet& sm) {
                 break;
             }
             case 5: {
+                std::cout << "请输入完全搜索时间上限（毫秒，0 表示只用贪心）: ";
+                int limit;
+                if(!(std::cin >> limit) || limit < 0) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "无效输入，请输入不小于0的整数。\n";
+                    break;
+                }
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                sm.findMinimumDays(limit);
+                break;
+            }
+            case 6: {
+                std::cout << "当前排程时间步长: " << sm.getScheduleTimeStep() << " 分钟\n";
+                std::cout << "请输入新的排程时间步长（1-60 分钟）: ";
+                int minutes;
+                if(!(std::cin >> minutes)) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "无效输入，请输入数字。\n";
+                    break;
+                }
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                sm.setScheduleTimeStep(minutes);
+                break;
+            }
+            case 7: {
+                std::cout << "当前排程线程数: " << sm.getScheduleThreads() << "\n";
+                std::cout << "请输入新的排程线程数（1 为串行，最多 64）: ";
+                int threads;
+                if(!(std::cin >> threads)) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "无效输入，请输入数字。\n";
+                    break;
+                }
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                sm.setScheduleThreads(threads);
+                break;
+            }
+            case 8:
+                handleVenueSettings(sm);
+                break;
+            case 9: {
                 std::cout << "\n--- 当前系统设置 ---\n";
                 std::cout << "运动员参赛项目数目限制: " << sm.getMaxEventsPerAthlete() << "\n";
                 std::cout << "比赛天数: " << sm.getCompetitionDays() << " 天\n";
+                std::cout << "排程时间步长: " << sm.getScheduleTimeStep() << " 分钟\n";
+                std::cout << "排程线程数: " << sm.getScheduleThreads() << "\n";
                 std::cout << "上午比赛时间段: " 
                           << sm.getMorningStartHour() << ":" 
                           << std::setw(2) << std::setfill('0') << sm.getMorningStartMinute()
@@ -608,9 +848,10 @@ void handleSystemSettings(SportsMeet& sm) {
                           << " - " 
                           << sm.getAfternoonEndHour() << ":" 
                           << std::setw(2) << std::setfill('0') << sm.getAfternoonEndMinute() << "\n";
+                std::cout << "场地数: " << sm.getVenues().size() << "\n";
                 break;
             }
-            case 6:
+            case 10:
                 return;
             default:
                 std::cout << "无效选项，请重试。\n";